@@ -3,7 +3,7 @@
 # be added to the unit testing executable.
 file(GLOB_RECURSE TEST_SOURCE_FILES ${CMAKE_SOURCE_DIR}/test/*.cpp)
 add_executable(unit_test ${SOURCE_FILES_NO_MAIN} ${TEST_SOURCE_FILES})
-target_link_libraries(unit_test ${CURSES_LIBRARIES})
+target_link_libraries(unit_test ${CURSES_LIBRARIES} Threads::Threads)
 
 # Enable CMake `make test` support.
 enable_testing()
@@ -0,0 +1,121 @@
+#ifndef COLLECTOR_H
+#define COLLECTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "snapshot.h"
+#include "system.h"
+
+/**
+ * @brief Collector refreshes the system on its own thread and publishes
+ * each refresh as an immutable Snapshot.
+ * The latest snapshot is swapped atomically (RCU style): the renderer takes
+ * a reference to it and draws it at its own pace, a slow refresh never
+ * blocks the screen. The reader hands back the snapshots it's done with
+ * through Release, the next refreshes fill them again instead of
+ * allocating new ones.
+ */
+class Collector final {
+public:
+  /**
+   * @brief Number of released snapshots kept for the next refreshes.
+   */
+  static constexpr std::size_t SNAPSHOTS{2};
+  /**
+   * @brief Construct a new Collector, the thread is started by Start.
+   *
+   * @param system  system to refresh, owned by the collector thread while it
+   * runs.
+   */
+  explicit Collector(System &system);
+  Collector(const Collector &) = delete;
+  Collector &operator=(const Collector &) = delete;
+  /**
+   * @brief Destroy the Collector, stopping the thread.
+   */
+  ~Collector();
+  /**
+   * @brief Start the collector thread, the first refresh is immediate.
+   */
+  void Start();
+  /**
+   * @brief Stop the collector thread and wait for it.
+   */
+  void Stop();
+  /**
+   * @brief Collect refreshes the system and publishes a snapshot, on the
+   * calling thread.
+   */
+  void Collect();
+  /**
+   * @brief Latest returns the last published snapshot.
+   *
+   * @return std::shared_ptr<const Snapshot> the snapshot, nullptr before the
+   * first refresh.
+   */
+  std::shared_ptr<const Snapshot> Latest() const;
+  /**
+   * @brief RecordRender reports the cost of drawing a snapshot, it's
+   * accounted in the budget of the next refresh.
+   *
+   * @param duration time spent drawing.
+   */
+  void RecordRender(std::chrono::nanoseconds duration) noexcept;
+  /**
+   * @brief Release hands back a snapshot that the caller won't read
+   * anymore, nor any copy of it. A snapshot never released, or released
+   * while it's still the latest, is just freed with its last reference.
+   *
+   * @param snapshot a snapshot returned by Latest.
+   */
+  void Release(std::shared_ptr<const Snapshot> snapshot);
+  /**
+   * @brief SetThreadsMode shows or hides the threads of the processes, from
+   * any thread: the system is switched by the collector thread, which
+   * refreshes right away.
+   *
+   * @param enabled true for showing the threads.
+   */
+  void SetThreadsMode(bool enabled);
+  /**
+   * @brief ThreadsMode tells the mode asked by the last SetThreadsMode.
+   *
+   * @return true if the threads are shown.
+   */
+  bool ThreadsMode() const noexcept;
+
+private:
+  // loop of the collector thread.
+  void Run();
+  // a released snapshot or a new one.
+  std::shared_ptr<Snapshot> Recycle();
+
+  System &system_;
+  // read and written only through std::atomic_load and std::atomic_store.
+  std::shared_ptr<const Snapshot> latest_;
+  // handed back by the reader: the mutex orders its last reads before the
+  // writes of the collector.
+  std::mutex released_mutex_;
+  std::vector<std::shared_ptr<const Snapshot>> released_;
+  std::uint64_t sequence_{0};
+  // cost of the last rendering in ns, negative until the first one.
+  std::atomic<std::chrono::nanoseconds::rep> render_ns_{-1};
+  // asked by the reader, applied to the system by Collect.
+  std::atomic<bool> threads_mode_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool running_{false};
+  // the next refresh doesn't wait for the interval.
+  bool refresh_now_{false};
+  std::thread thread_;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef CPU_MONITOR_H
+#define CPU_MONITOR_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "system_stat.h"
+
+namespace LinuxParser {
+/**
+ * @brief CPUMonitor samples the cpu utilization in a background thread.
+ * Each sample is the utilization between two consecutive reads of
+ * /proc/stat, it's pushed in a lock-free ring buffer and the thread keeps
+ * the median and the exponential moving average up to date, so readers
+ * get them in O(1) without ever blocking on the sampling.
+ * The utilization of each core is computed from the same reads.
+ */
+class CPUMonitor final {
+public:
+  /**
+   * @brief Capacity of the ring buffer, a power of two.
+   */
+  static constexpr std::size_t RING_SIZE{16};
+  /**
+   * @brief Weight of the last sample in the moving average.
+   */
+  static constexpr float EMA_ALPHA{0.3f};
+  /**
+   * @brief Construct a new CPUMonitor, the sampling thread is not started.
+   *
+   * @param period  time between two samples.
+   * @param window  number of the last samples used for the median.
+   */
+  explicit CPUMonitor(std::chrono::milliseconds period,
+                      std::size_t window = RING_SIZE);
+  CPUMonitor(const CPUMonitor &) = delete;
+  CPUMonitor &operator=(const CPUMonitor &) = delete;
+  /**
+   * @brief Destroy the CPUMonitor object stopping the sampling thread.
+   */
+  ~CPUMonitor();
+  /**
+   * @brief Instance returns the process wide monitor, started at the first
+   * call with a period of CPUSampler::SAMPLING_TIME_MS.
+   *
+   * @return CPUMonitor& shared monitor.
+   */
+  static CPUMonitor &Instance();
+  /**
+   * @brief Start the sampling thread, if it's not already running.
+   */
+  void Start();
+  /**
+   * @brief Stop the sampling thread and wait for it.
+   */
+  void Stop();
+  /**
+   * @brief Change the time between two samples, it's applied from the next
+   * sample.
+   *
+   * @param period  time between two samples.
+   */
+  void SetPeriod(std::chrono::milliseconds period) noexcept;
+  /**
+   * @brief Median of the last samples.
+   *
+   * @return float utilization percentage (0-100), 0 before the first sample.
+   */
+  float Median() const noexcept;
+  /**
+   * @brief Exponential moving average of the samples.
+   *
+   * @return float utilization percentage (0-100), 0 before the first sample.
+   */
+  float Ema() const noexcept;
+  /**
+   * @brief Latest sample.
+   *
+   * @return float utilization percentage (0-100), 0 before the first sample.
+   */
+  float Latest() const noexcept;
+  /**
+   * @brief CoreUtilization returns the utilization of each core in the last
+   * sample.
+   *
+   * @return std::shared_ptr<const std::vector<float>> utilization (0-100) of
+   * each online core, in the /proc/stat order; empty before the first
+   * sample.
+   */
+  std::shared_ptr<const std::vector<float>> CoreUtilization() const;
+  /**
+   * @brief Samples returns how many samples have been taken.
+   *
+   * @return std::uint64_t number of samples.
+   */
+  std::uint64_t Samples() const noexcept;
+
+private:
+  // sampling loop of the thread.
+  void Run();
+  // push a sample in the ring and update the statistics.
+  void Push(float value) noexcept;
+
+  std::size_t window_;
+  std::atomic<std::int64_t> period_ms_;
+  // single producer ring: the sampling thread writes, anyone reads.
+  std::array<std::atomic<float>, RING_SIZE> ring_{};
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<float> median_{0.0f};
+  std::atomic<float> ema_{0.0f};
+  std::optional<CpuTimes> previous_;
+  CoreTimes previous_cores_;
+  // per core utilization, replaced atomically after each sample.
+  std::shared_ptr<const std::vector<float>> cores_;
+  bool running_{false};
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::thread thread_;
+};
+} // namespace LinuxParser
+#endif
@@ -33,8 +33,6 @@ public:
 private:
   // load data
   float LoadData() const;
-  // convert the /proc/stat counter in vector of values
-  std::vector<int> Split(const std::string &input) const;
   // number of samples
   int samples_;
   // callback
@@ -0,0 +1,103 @@
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief CpuTopology describes how the online logical cpus are laid out in
+ * cores, sockets and NUMA nodes. It is read from /sys/devices/system just
+ * once and shared: a new topology is loaded only calling Refresh, i.e. after
+ * a cpu hotplug.
+ */
+class CpuTopology final {
+public:
+  /**
+   * @brief Descriptor of a single logical cpu.
+   */
+  struct LogicalCpu {
+    unsigned int id{0};
+    int package{0};
+    int core{0};
+    int node{0};
+  };
+  /**
+   * @brief Current returns the shared topology, it's detected at the first
+   * call.
+   *
+   * @return std::shared_ptr<const CpuTopology> current topology, it stays
+   * valid while it's used even if another thread refreshes it.
+   */
+  static std::shared_ptr<const CpuTopology> Current();
+  /**
+   * @brief Refresh detects again the topology and replace the shared one.
+   * It's meant to be called on cpu hotplug.
+   *
+   * @return std::shared_ptr<const CpuTopology> the new topology.
+   */
+  static std::shared_ptr<const CpuTopology> Refresh();
+  /**
+   * @brief Detect the topology from sysfs.
+   * If sysfs is not available we fall back to the number of online cpus
+   * reported by sysconf on a single socket and a single node.
+   *
+   * @param cpu_root   path of the cpu directory (/sys/devices/system/cpu)
+   * @param node_root  path of the node directory (/sys/devices/system/node)
+   * @return CpuTopology the detected topology.
+   */
+  static CpuTopology Detect(const std::filesystem::path &cpu_root,
+                            const std::filesystem::path &node_root);
+  /**
+   * @brief Parse a kernel cpu list (i.e. 0-3,8,10-11).
+   *
+   * @param list the list to parse.
+   * @return std::vector<unsigned int> the sorted ids in the list.
+   */
+  static std::vector<unsigned int> ParseCpuList(std::string_view list);
+  /**
+   * @brief OnlineCpus returns the number of online logical cpus.
+   *
+   * @return unsigned int number of logical cpus, at least 1.
+   */
+  unsigned int OnlineCpus() const noexcept;
+  /**
+   * @brief Cores returns the number of physical cores.
+   *
+   * @return unsigned int number of cores.
+   */
+  unsigned int Cores() const noexcept;
+  /**
+   * @brief Sockets returns the number of physical packages.
+   *
+   * @return unsigned int number of sockets.
+   */
+  unsigned int Sockets() const noexcept;
+  /**
+   * @brief NumaNodes returns the number of the NUMA nodes with cpus.
+   *
+   * @return unsigned int number of nodes.
+   */
+  unsigned int NumaNodes() const noexcept;
+  /**
+   * @brief ThreadsPerCore returns the SMT siblings of a core.
+   *
+   * @return unsigned int number of threads for each core.
+   */
+  unsigned int ThreadsPerCore() const noexcept;
+  /**
+   * @brief Cpus returns the descriptors of the online logical cpus.
+   *
+   * @return const std::vector<LogicalCpu>& cpus sorted by id.
+   */
+  const std::vector<LogicalCpu> &Cpus() const noexcept;
+
+private:
+  std::vector<LogicalCpu> cpus_;
+  unsigned int cores_{1};
+  unsigned int sockets_{1};
+  unsigned int nodes_{1};
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef CPU_USAGE_TRACKER_H
+#define CPU_USAGE_TRACKER_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * @brief CpuUsageTracker keeps the cpu time of each process seen in the
+ * previous refresh, so the cpu usage is the one between two consecutive
+ * refreshes (like top does) and not the average since the process started.
+ * Processes are identified by pid and start time, a reused pid is a new
+ * process.
+ */
+class CpuUsageTracker final {
+public:
+  /**
+   * @brief Start a new refresh.
+   *
+   * @param total_jiffies total cpu time from the aggregate line of /proc/stat
+   * @param num_cpus number of online cpus
+   */
+  void BeginTick(unsigned long long total_jiffies, unsigned int num_cpus);
+  /**
+   * @brief Record the cpu time of a process and compute its usage.
+   *
+   * @param pid        process id
+   * @param start_time start time of the process in clock ticks after boot
+   * @param ticks      utime + stime of the process
+   * @return std::optional<float> fraction of a cpu used since the previous
+   * refresh, std::nullopt in the first refresh where there is no period yet.
+   */
+  std::optional<float> Usage(int pid, unsigned long long start_time,
+                             unsigned long long ticks);
+  /**
+   * @brief Average usage of a process since boot, for the first refresh
+   * where Usage has no period yet.
+   *
+   * @param ticks      utime + stime of the process
+   * @return float fraction of a cpu used, 0 without a total.
+   */
+  float Average(unsigned long long ticks) const noexcept;
+  /**
+   * @brief Keep a process that is not sampled in this refresh (i.e. an idle
+   * one read less often): it's not forgotten by EndTick and its next usage
+   * is computed over all the time since its last sample.
+   *
+   * @param pid        process id
+   * @param start_time start time of the process in clock ticks after boot
+   * @return std::optional<float> the usage of the last sample, std::nullopt
+   * if the process is not tracked.
+   */
+  std::optional<float> Keep(int pid, unsigned long long start_time);
+  /**
+   * @brief Finish the refresh forgetting the processes that have exited.
+   */
+  void EndTick();
+  /**
+   * @brief Size returns the number of tracked processes.
+   *
+   * @return std::size_t number of processes.
+   */
+  std::size_t Size() const noexcept;
+
+private:
+  struct Key {
+    int pid;
+    unsigned long long start_time;
+    bool operator==(const Key &other) const noexcept {
+      return pid == other.pid && start_time == other.start_time;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const noexcept {
+      return std::hash<unsigned long long>{}(
+          (static_cast<unsigned long long>(key.pid) << 32) ^ key.start_time);
+    }
+  };
+  struct Sample {
+    unsigned long long ticks{0};
+    float usage{0.0f};
+    unsigned long long generation{0};
+    // total jiffies when ticks was read.
+    unsigned long long total{0};
+  };
+
+  std::unordered_map<Key, Sample, KeyHash> samples_;
+  // jiffies of the previous refresh.
+  unsigned long long last_total_{0};
+  // period between the two refreshes in jiffies of a single cpu.
+  double period_{0.0};
+  unsigned int num_cpus_{1};
+  unsigned long long generation_{0};
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef EXPECTED_H
+#define EXPECTED_H
+
+#include <utility>
+#include <variant>
+
+namespace util {
+/**
+ * @brief Unexpected wraps the error used to build a failed Expected.
+ */
+template <typename E> struct Unexpected {
+  E error;
+};
+
+/**
+ * @brief Create an Unexpected, i.e. return util::unexpected(Error::kFoo);
+ *
+ * @param error the error.
+ * @return Unexpected<E>
+ */
+template <typename E> Unexpected<E> unexpected(E error) {
+  return Unexpected<E>{error};
+}
+
+/**
+ * @brief Expected holds either a value or the error that prevented to get
+ * it, a small subset of C++23 std::expected. It's meant for the paths where
+ * a failure is ordinary (i.e. a process exiting while we read it) and an
+ * exception would be too expensive.
+ *
+ * @tparam T type of the value
+ * @tparam E type of the error
+ */
+template <typename T, typename E> class Expected final {
+public:
+  Expected(T value) : data_(std::in_place_index<0>, std::move(value)) {}
+  Expected(Unexpected<E> error) : data_(std::in_place_index<1>, error.error) {}
+
+  bool has_value() const noexcept { return data_.index() == 0; }
+  explicit operator bool() const noexcept { return has_value(); }
+  /**
+   * @brief The value, it shall be called only if has_value().
+   */
+  T &value() & { return std::get<0>(data_); }
+  const T &value() const & { return std::get<0>(data_); }
+  T &&value() && { return std::get<0>(std::move(data_)); }
+  /**
+   * @brief The error, it shall be called only if !has_value().
+   */
+  E error() const { return std::get<1>(data_); }
+
+  T &operator*() & { return value(); }
+  const T &operator*() const & { return value(); }
+  T *operator->() { return &value(); }
+  const T *operator->() const { return &value(); }
+
+private:
+  std::variant<T, E> data_;
+};
+} // namespace util
+#endif
@@ -1,10 +1,22 @@
 #ifndef FORMAT_H
 #define FORMAT_H
 
+#include <array>
 #include <string>
+#include <string_view>
 
 namespace Format {
+/**
+ * @brief Field is a buffer for a formatted value. The overloads taking a
+ * field write the value there with to_chars and return a view on it, so a
+ * frame is rendered without allocating.
+ */
+using Field = std::array<char, 64>;
 std::string ElapsedTime(long times); // TODO: See src/format.cpp
+std::string Megabytes(unsigned long long bytes);
+std::string_view ElapsedTime(long times, Field &field) noexcept;
+std::string_view Megabytes(unsigned long long bytes, Field &field) noexcept;
+std::string_view Percent(float ratio, Field &field) noexcept;
 };                                   // namespace Format
 
-#endif
\ No newline at end of file
+#endif
@@ -3,15 +3,54 @@
 
 #include <curses.h>
 
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include "format.h"
 #include "process.h"
+#include "process_table.h"
+#include "process_view.h"
+#include "screen_buffer.h"
+#include "snapshot.h"
 #include "system.h"
 
 namespace NCursesDisplay {
-constexpr int MAX_PROCESSES_DISPLAY = 18;
-void Display(System &system, const int &n = MAX_PROCESSES_DISPLAY);
-void DisplaySystem(System &system, WINDOW *window);
-void DisplayProcesses(std::vector<Process> &processes, WINDOW *window, int n);
+// rows of the system window.
+constexpr int SYSTEM_ROWS = 9;
+// rows of the process window around the processes: the borders, the header
+// and the status line.
+constexpr int PROCESS_FRAME_ROWS = 4;
+// narrower, the columns of the processes overlap.
+constexpr int MIN_COLUMNS = 60;
+// the screen is checked for a new snapshot and for keys at this pace.
+constexpr std::chrono::milliseconds FRAME_INTERVAL{100};
+// windows of the display and the cells they show.
+struct Screen {
+  WINDOW *system_window{nullptr};
+  WINDOW *process_window{nullptr};
+  // inside the box of the windows.
+  ScreenBuffer system_buffer{0, 0, 1};
+  ScreenBuffer process_buffer{0, 0, 1};
+  // false when the terminal is too small for the windows.
+  bool fits{false};
+};
+void Display(System &system);
+// size the windows and the view to the terminal.
+void Layout(Screen &screen, ProcessView &view);
+void DisplaySystem(const Snapshot &system, ScreenBuffer &buffer);
+void DisplayProcesses(const ProcessView &view, ScreenBuffer &buffer,
+                      bool searching = false);
+// what the display does after a key.
+enum class Action { kNone, kRedraw, kQuit, kToggleThreads };
+// apply a key to the view; while searching, the keys edit the search.
+Action HandleKey(int key, ProcessView &view, std::string &search,
+                 bool &searching);
+// draw the changes of the buffer in the window, on the next doupdate.
+void Draw(ScreenBuffer &buffer, WINDOW *window);
 std::string ProgressBar(float percent);
+// the bar written in a field, without allocating.
+std::string_view ProgressBar(float percent, Format::Field &field) noexcept;
 }; // namespace NCursesDisplay
 
 #endif
\ No newline at end of file
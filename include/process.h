@@ -3,9 +3,39 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
+
+#include "cpu_usage_tracker.h"
+#include "expected.h"
+#include "process_stat.h"
+#include "process_statm.h"
+#include "process_status.h"
+#include "string_pool.h"
+#include "system_stat.h"
 // forward declaration
 class Process;
 
+/**
+ * @brief Reasons why a process cannot be built.
+ */
+enum class ProcessError {
+  // the pid is not a valid one.
+  kInvalidPid,
+  // there is no such process (ENOENT), it had exited before the read.
+  kNotFound,
+  // the process has exited while we were reading it (ESRCH).
+  kExited,
+  // a file of the process has an unexpected content.
+  kParseError
+};
+/**
+ * @brief Describe an error, i.e. for logs or exceptions.
+ *
+ * @param error
+ * @return std::string
+ */
+std::string ToString(ProcessError error);
+
 /**
  * @brief ProcessBuolder is a builder class for the Process,
  * it scans the /proc/PID and fetch all the values.
@@ -21,53 +51,126 @@ public:
    * @return Process
    */
   static Process Build(const std::filesystem::path &process_dir);
-
-private:
   /**
-   * @brief Find the process user information using the /proc fs.
+   * @brief Build a process passing its path and the /proc/stat of the
+   * current refresh, shared by all the processes. Without a previous
+   * refresh its cpu usage is the average since boot.
    *
-   * @param base path in proc of the current process
-   * @return std::string user name of the current process user.
+   * @param process_dir
+   * @param system_stat /proc/stat captured for this refresh
+   * @return Process
+   * @throw std::invalid_argument if the directory is not a pid.
+   * @throw std::runtime_error if the process cannot be read.
    */
-  static std::string FindUser(const std::filesystem::path &base);
+  static Process Build(const std::filesystem::path &process_dir,
+                       const LinuxParser::SystemStatSnapshot &system_stat);
   /**
-   * @brief Find uptime for the current process
+   * @brief Build a process without exceptions: processes exiting during a
+   * refresh are ordinary, they are reported as errors. The cpu usage is
+   * computed afterwards by UpdateCpuUsage.
    *
-   * @param base  path in proc fo the current base
-   * @return long time in seconds of the uptime.
+   * @param pid  process id
+   * @param strings cache of the worker where the user and the command are
+   * interned.
+   * @return util::Expected<Process, ProcessError> the process or why it
+   * cannot be built.
+   */
+  static util::Expected<Process, ProcessError>
+  TryBuild(int pid, StringPool::Cache &strings);
+  /**
+   * @brief Build a process without exceptions, its strings are interned in
+   * the shared pool.
+   *
+   * @param pid  process id
+   * @return util::Expected<Process, ProcessError> the process or why it
+   * cannot be built.
+   */
+  static util::Expected<Process, ProcessError> TryBuild(int pid);
+  /**
+   * @brief Build a thread of a process reading /proc/PID/task/TID/stat.
+   * User and memory are the ones of the process, the command is the name
+   * of the thread.
+   *
+   * @param process process owning the thread
+   * @param tid  thread id
+   * @param strings cache of the worker where the name of the thread is
+   * interned.
+   * @return util::Expected<Process, ProcessError> the thread or why it
+   * cannot be built.
    */
-  static long FindUptime(const std::filesystem::path &base);
+  static util::Expected<Process, ProcessError>
+  TryBuildThread(const Process &process, int tid, StringPool::Cache &strings);
   /**
-   * @brief Find the cpu usage for the current process.
+   * @brief Mark the strings of a process as used in the current generation
+   * of the pool.
    *
-   * @param base  path in /proc for the current process
-   * @return float cpu usage for the current process
+   * @param process process built with the pool.
+   * @param strings pool used for building the process.
    */
-  static float FindCpuUsage(const std::filesystem::path &base);
+  static void MarkStrings(const Process &process, StringPool &strings);
   /**
-   * @brief Find memory usage for the current process
+   * @brief Update the values of a process that change between two
+   * refreshes (cpu time and memory), re-reading only /proc/PID/stat and
+   * /proc/PID/statm. The user and the command are kept.
    *
-   * @param base path in /proc for the current process
-   * @return std::string memory usage.
+   * @param process  process built in a previous refresh
+   * @param strings  if given, the command line is read again (it changes
+   * with exec) and interned through the cache.
+   * @return true if the process has been updated, false if it has exited or
+   * its pid belongs now to another process.
    */
-  static std::string FindMemoryUsage(const std::filesystem::path &base);
+  static bool Update(Process &process, StringPool::Cache *strings = nullptr);
+  /**
+   * @brief Skip a process in this refresh: its values are kept and its
+   * cpu usage is not computed (i.e. an idle process sampled less often).
+   *
+   * @param process  process built in a previous refresh
+   */
+  static void Skip(Process &process);
+  /**
+   * @brief Update the cpu usage of a process with the one since the previous
+   * refresh. In the first refresh it's the average since boot.
+   *
+   * @param process  process built in the current refresh
+   * @param tracker  cpu time of the processes in the previous refresh
+   */
+  static void UpdateCpuUsage(Process &process, CpuUsageTracker &tracker);
 
+private:
   /**
-   * @brief Find the current command for the current process
+   * @brief Find the process user information using the /proc fs.
+   *
+   * @param status  parsed /proc/PID/status of the current process
+   * @return std::string user name of the current process user.
+   */
+  static std::string FindUser(const LinuxParser::ProcessStatus &status);
+  /**
+   * @brief Find uptime for the current process
    *
-   * @param base  path in /proc for the current process
-   * @return std::string
+   * @param stat  parsed /proc/PID/stat record of the current process
+   * @return long time in seconds of the uptime.
    */
-  static std::string FindCommand(const std::filesystem::path &base);
+  static long FindUptime(const LinuxParser::ProcessStat &stat);
   /**
-   * @brief Get the average cpu total time.
-   * We'll use this for computing the process time.
+   * @brief Find memory usage for the current process, in bytes.
    *
-   * @param num_cpu Number of the cpu in the system
-   * @return unsigned long long int
+   * @param process  process to update
+   * @param statm  parsed /proc/PID/statm of the current process
    */
+  static void FindMemoryUsage(Process &process,
+                              const LinuxParser::ProcessStatm &statm);
 
-  static unsigned long long int GetTotalCpuUsage(unsigned int num_cpu);
+  /**
+   * @brief Find the current command for the current process
+   *
+   * @param pid   process id of the current process
+   * @param stat  parsed /proc/PID/stat record, its comm is the fallback
+   * for processes without a command line (i.e. kernel threads).
+   * @return std::string_view the command, valid until the next procfs read
+   * of the thread (or as long as stat).
+   */
+  static std::string_view FindCommand(int pid,
+                                      const LinuxParser::ProcessStat &stat);
 };
 
 /**
@@ -83,18 +186,31 @@ public:
    */
 
   int Pid() const noexcept;
+  /**
+   * @brief Tgid  Process ID of the process owning a thread, the pid itself
+   * for a process.
+   *
+   * @return int  the thread group id
+   */
+  int Tgid() const noexcept;
+  /**
+   * @brief IsThread tells if this is a thread of a process.
+   *
+   * @return true for a thread (/proc/PID/task/TID).
+   */
+  bool IsThread() const noexcept;
   /**
    * @brief User  User in the system for the process.
    *
-   * @return std::string username associated to the process.
+   * @return std::string_view username associated to the process.
    */
-  std::string User() const noexcept;
+  std::string_view User() const noexcept;
   /**
    * @brief Command command line argument for the process.
    *
-   * @return std::string A command associated with the process.
+   * @return std::string_view A command associated with the process.
    */
-  std::string Command() const noexcept;
+  std::string_view Command() const noexcept;
   /**
    * @brief CpuUtilization current CPU usage for this process
    *
@@ -102,17 +218,36 @@ public:
    */
   float CpuUtilization() const noexcept;
   /**
-   * @brief Ram used for this process.
+   * @brief Vsz total virtual memory of this process (VmSize).
+   *
+   * @return unsigned long long size in bytes, 0 for kernel threads.
+   */
+  unsigned long long Vsz() const noexcept;
+  /**
+   * @brief Rss resident memory of this process (VmRSS).
    *
-   * @return std::string
+   * @return unsigned long long size in bytes.
    */
-  std::string Ram() const noexcept;
+  unsigned long long Rss() const noexcept;
+  /**
+   * @brief Shared resident memory backed by files or shared memory.
+   *
+   * @return unsigned long long size in bytes.
+   */
+  unsigned long long Shared() const noexcept;
   /**
    * @brief Uptime for this process.
    *
    * @return long int uptime
    */
   long int UpTime() const noexcept;
+  /**
+   * @brief IdleRefreshes number of consecutive refreshes in which the
+   * process has not used the cpu.
+   *
+   * @return unsigned int number of refreshes.
+   */
+  unsigned int IdleRefreshes() const noexcept;
   /**
    * @brief A comparator opertator for sorting the processes.
    *
@@ -124,16 +259,30 @@ public:
 
 private:
   int pid_;
-  std::string user_;
-  std::string command_;
-  std::string ram_;
+  int tgid_{0};
+  bool thread_{false};
+  // interned, many processes share them.
+  StringPool::Handle user_;
+  StringPool::Handle command_;
+  // memory in bytes.
+  unsigned long long vsz_{0};
+  unsigned long long rss_{0};
+  unsigned long long shared_{0};
   long int uptime_;
-  float cpu_usage_;
+  float cpu_usage_{0.0f};
+  // start time after boot and utime + stime, in clock ticks.
+  unsigned long long start_time_{0};
+  unsigned long long cpu_ticks_{0};
+  unsigned int idle_refreshes_{0};
+  // false if the process has been skipped in this refresh.
+  bool sampled_{true};
   // this is because i want encapsulate the creation.
   // I dont want to give to the user to do a new Process();
   // the alternative can be creat constructor with k params
   // or setters but it's a bit more code.
   friend ProcessBuilder;
+  // copies the handles of the strings.
+  friend class ProcessTable;
 };
 
 #endif
\ No newline at end of file
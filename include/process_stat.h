@@ -0,0 +1,116 @@
+#ifndef PROCESS_STAT_H
+#define PROCESS_STAT_H
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace LinuxParser {
+/**
+ * @brief ProcessStat is the typed content of a /proc/PID/stat record.
+ * The fields follow the order and the naming of proc(5).
+ * Fields that are missing in older kernels are left to zero.
+ */
+struct ProcessStat {
+  /**
+   * @brief Max length of the comm field that we keep.
+   * The kernel limits it to 16 bytes for user tasks and to 64 for kthreads.
+   */
+  static constexpr std::size_t COMM_SIZE{64};
+  /**
+   * @brief Comm returns the name of the executable (without parenthesis).
+   *
+   * @return std::string_view view on the comm field stored in the record.
+   */
+  std::string_view Comm() const noexcept {
+    return std::string_view(comm.data(), comm_length);
+  }
+
+  int pid{0};
+  std::array<char, COMM_SIZE> comm{};
+  std::size_t comm_length{0};
+  char state{'?'};
+  int ppid{0};
+  int pgrp{0};
+  int session{0};
+  int tty_nr{0};
+  int tpgid{0};
+  unsigned int flags{0};
+  unsigned long minflt{0};
+  unsigned long cminflt{0};
+  unsigned long majflt{0};
+  unsigned long cmajflt{0};
+  unsigned long utime{0};
+  unsigned long stime{0};
+  long cutime{0};
+  long cstime{0};
+  long priority{0};
+  long nice{0};
+  long num_threads{0};
+  long itrealvalue{0};
+  unsigned long long starttime{0};
+  unsigned long vsize{0};
+  long rss{0};
+  unsigned long rsslim{0};
+  unsigned long startcode{0};
+  unsigned long endcode{0};
+  unsigned long startstack{0};
+  unsigned long kstkesp{0};
+  unsigned long kstkeip{0};
+  unsigned long signal{0};
+  unsigned long blocked{0};
+  unsigned long sigignore{0};
+  unsigned long sigcatch{0};
+  unsigned long wchan{0};
+  unsigned long nswap{0};
+  unsigned long cnswap{0};
+  int exit_signal{0};
+  int processor{0};
+  unsigned int rt_priority{0};
+  unsigned int policy{0};
+  unsigned long long delayacct_blkio_ticks{0};
+  unsigned long guest_time{0};
+  long cguest_time{0};
+  unsigned long start_data{0};
+  unsigned long end_data{0};
+  unsigned long start_brk{0};
+  unsigned long arg_start{0};
+  unsigned long arg_end{0};
+  unsigned long env_start{0};
+  unsigned long env_end{0};
+  int exit_code{0};
+};
+
+/**
+ * @brief Parse a /proc/PID/stat record without allocating memory.
+ * The comm field is delimited by the first '(' and the last ')', so
+ * executable names containing spaces or parenthesis are handled.
+ *
+ * @param record content of the stat file.
+ * @return std::optional<ProcessStat> std::nullopt if the record is malformed.
+ */
+std::optional<ProcessStat> ParseProcessStat(std::string_view record) noexcept;
+
+/**
+ * @brief Read /proc/PID/stat once and parse it.
+ *
+ * @param process_dir path of the process in /proc (i.e. /proc/self)
+ * @return std::optional<ProcessStat> std::nullopt if the file cannot be read
+ * or parsed.
+ */
+std::optional<ProcessStat>
+ReadProcessStat(const std::filesystem::path &process_dir);
+
+/**
+ * @brief Read /proc/PID/stat of a process through the cached directory of
+ * the process and parse it.
+ *
+ * @param pid process id
+ * @return std::optional<ProcessStat> std::nullopt if the process is gone
+ * or the file cannot be parsed.
+ */
+std::optional<ProcessStat> ReadProcessStat(int pid);
+} // namespace LinuxParser
+#endif
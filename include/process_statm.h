@@ -0,0 +1,48 @@
+#ifndef PROCESS_STATM_H
+#define PROCESS_STATM_H
+
+#include <optional>
+#include <string_view>
+
+namespace LinuxParser {
+/**
+ * @brief ProcessStatm is the content of /proc/PID/statm, the memory of a
+ * process measured in pages. It's a single short line: much cheaper to read
+ * and parse than the Vm* lines of /proc/PID/status.
+ */
+struct ProcessStatm {
+  // total program size, as VmSize.
+  unsigned long size{0};
+  // resident set size, as VmRSS.
+  unsigned long resident{0};
+  // resident shared pages (file backed), as RssFile + RssShmem.
+  unsigned long shared{0};
+  unsigned long text{0};
+  // unused since Linux 2.6, always 0.
+  unsigned long lib{0};
+  // data + stack.
+  unsigned long data{0};
+  // unused since Linux 2.6, always 0.
+  unsigned long dt{0};
+};
+
+/**
+ * @brief Parse the content of /proc/PID/statm without allocating memory.
+ *
+ * @param content content of the statm file.
+ * @return std::optional<ProcessStatm> std::nullopt if a field is missing.
+ */
+std::optional<ProcessStatm>
+ParseProcessStatm(std::string_view content) noexcept;
+
+/**
+ * @brief Read /proc/PID/statm of a process through the cached directory of
+ * the process and parse it.
+ *
+ * @param pid process id
+ * @return std::optional<ProcessStatm> std::nullopt if the process is gone
+ * or the file cannot be parsed.
+ */
+std::optional<ProcessStatm> ReadProcessStatm(int pid);
+} // namespace LinuxParser
+#endif
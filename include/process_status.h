@@ -0,0 +1,109 @@
+#ifndef PROCESS_STATUS_H
+#define PROCESS_STATUS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace LinuxParser {
+/**
+ * @brief ProcessStatus is the typed content of /proc/PID/status.
+ * Memory values are in kB as reported by the kernel. The Vm* fields
+ * are zero for kernel threads, they don't have an address space.
+ */
+struct ProcessStatus {
+  /**
+   * @brief Max length of the Name field that we keep.
+   */
+  static constexpr std::size_t NAME_SIZE{64};
+  /**
+   * @brief Name returns the name of the executable.
+   *
+   * @return std::string_view view on the name stored in the record.
+   */
+  std::string_view Name() const noexcept {
+    return std::string_view(name.data(), name_length);
+  }
+
+  std::array<char, NAME_SIZE> name{};
+  std::size_t name_length{0};
+  char state{'?'};
+  int tgid{0};
+  int pid{0};
+  int ppid{0};
+  int tracer_pid{0};
+  // real, effective, saved set and filesystem ids.
+  std::array<unsigned int, 4> uid{};
+  std::array<unsigned int, 4> gid{};
+  unsigned long fd_size{0};
+  unsigned long vm_peak{0};
+  unsigned long vm_size{0};
+  unsigned long vm_lck{0};
+  unsigned long vm_pin{0};
+  unsigned long vm_hwm{0};
+  unsigned long vm_rss{0};
+  unsigned long rss_anon{0};
+  unsigned long rss_file{0};
+  unsigned long rss_shmem{0};
+  unsigned long vm_data{0};
+  unsigned long vm_stk{0};
+  unsigned long vm_exe{0};
+  unsigned long vm_lib{0};
+  unsigned long vm_pte{0};
+  unsigned long vm_swap{0};
+  unsigned long threads{0};
+  unsigned long voluntary_ctxt_switches{0};
+  unsigned long nonvoluntary_ctxt_switches{0};
+};
+
+/**
+ * @brief Compile time hash of a status key (FNV-1a).
+ * It is used for dispatching the keys with a switch: two keys of the table
+ * with the same hash would be a duplicated case label and would not compile.
+ *
+ * @param key key of the status line (i.e. VmRSS)
+ * @return constexpr std::uint32_t hash of the key.
+ */
+constexpr std::uint32_t StatusKeyHash(std::string_view key) noexcept {
+  std::uint32_t hash{2166136261u};
+  for (auto c : key) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Parse the content of /proc/PID/status without allocating memory.
+ * Unknown keys are skipped.
+ *
+ * @param content content of the status file.
+ * @return std::optional<ProcessStatus> std::nullopt if there is no Uid line,
+ * that is always present in a valid status.
+ */
+std::optional<ProcessStatus>
+ParseProcessStatus(std::string_view content) noexcept;
+
+/**
+ * @brief Read /proc/PID/status and parse it.
+ *
+ * @param process_dir path of the process in /proc (i.e. /proc/1)
+ * @return std::optional<ProcessStatus> std::nullopt if the file cannot be
+ * read or parsed.
+ */
+std::optional<ProcessStatus>
+ReadProcessStatus(const std::filesystem::path &process_dir);
+
+/**
+ * @brief Read /proc/PID/status of a process through the cached directory of
+ * the process and parse it.
+ *
+ * @param pid process id
+ * @return std::optional<ProcessStatus> std::nullopt if the process is gone
+ * or the file cannot be parsed.
+ */
+std::optional<ProcessStatus> ReadProcessStatus(int pid);
+} // namespace LinuxParser
+#endif
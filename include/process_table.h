@@ -0,0 +1,146 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "process.h"
+#include "string_pool.h"
+
+/**
+ * @brief Columns that can order the processes.
+ */
+enum class SortKey { kPid, kUser, kCpu, kMemory, kTime, kCommand };
+
+/**
+ * @brief ProcessTable is a columnar copy of the processes of a refresh.
+ * Each value has its own contiguous array and the strings are ranges of a
+ * single buffer, so a pass on a column (sorting, filtering) touches only
+ * that column and reading a row doesn't copy anything. Having no pointers,
+ * the table is copied array by array.
+ */
+class ProcessTable final {
+public:
+  ProcessTable() = default;
+  ProcessTable(const ProcessTable &) = delete;
+  ProcessTable &operator=(const ProcessTable &) = delete;
+  /**
+   * @brief Clear removes all the rows, the memory is kept for the next
+   * fill.
+   */
+  void Clear() noexcept;
+  /**
+   * @brief Reserve room for a number of rows.
+   *
+   * @param rows expected number of rows.
+   */
+  void Reserve(std::size_t rows);
+  /**
+   * @brief Append a process at the end of the table. The threads of a
+   * process, if any, are appended right after it. Its strings are copied
+   * the first time their handles are seen since Clear.
+   *
+   * @param process
+   */
+  void Append(const Process &process);
+  /**
+   * @brief Assign replaces the rows with a copy of another table, order
+   * included. The arrays are copied as they are, strings included, so the
+   * copy doesn't depend on the other one; the memory of this table is
+   * reused.
+   *
+   * @param other table to copy.
+   */
+  void Assign(const ProcessTable &other);
+  /**
+   * @brief Size returns the number of rows.
+   *
+   * @return std::size_t number of rows.
+   */
+  std::size_t Size() const noexcept { return pid_.size(); }
+
+  int Pid(std::size_t row) const noexcept { return pid_[row]; }
+  bool IsThread(std::size_t row) const noexcept { return thread_[row]; }
+  std::string_view User(std::size_t row) const noexcept {
+    return View(user_[row]);
+  }
+  std::string_view Command(std::size_t row) const noexcept {
+    return View(command_[row]);
+  }
+  float CpuUtilization(std::size_t row) const noexcept { return cpu_[row]; }
+  unsigned long long Vsz(std::size_t row) const noexcept { return vsz_[row]; }
+  unsigned long long Rss(std::size_t row) const noexcept { return rss_[row]; }
+  long int UpTime(std::size_t row) const noexcept { return uptime_[row]; }
+  /**
+   * @brief Sort orders the rows by a column. Only the first top rows are
+   * fully ordered: they are selected with nth_element and then sorted, so
+   * the cost for the few rows shown on the screen is linear in the rows of
+   * the table. Equal keys are ordered by pid.
+   * The threads stay under their process, ordered by the same key.
+   *
+   * @param key         column to order by.
+   * @param descending  true for the largest values first.
+   * @param top         number of rows to be ordered, the others follow in
+   * no particular order.
+   */
+  void Sort(SortKey key, bool descending, std::size_t top);
+  /**
+   * @brief Order returns the rows in the order of the last Sort, in pid
+   * order if the table has not been sorted since it was filled.
+   *
+   * @return const std::vector<std::size_t>& indexes of the rows.
+   */
+  const std::vector<std::size_t> &Order() const noexcept { return order_; }
+  /**
+   * @brief The columns, for the passes on all the rows.
+   */
+  const std::vector<int> &Pids() const noexcept { return pid_; }
+  const std::vector<float> &CpuUtilizations() const noexcept { return cpu_; }
+  const std::vector<long int> &UpTimes() const noexcept { return uptime_; }
+  const std::vector<unsigned long long> &Vszs() const noexcept { return vsz_; }
+
+private:
+  // a string in text_.
+  struct Text {
+    std::uint32_t offset;
+    std::uint32_t size;
+  };
+  std::string_view View(Text text) const noexcept {
+    return std::string_view(text_.data() + text.offset, text.size);
+  }
+  // the text of a handle, copied in text_ the first time.
+  Text Store(StringPool::Handle handle);
+  // order rows by key, only the first top are ordered. rows are given in
+  // row (pid) order; rows and order can be the same vector.
+  void SortRows(const std::vector<std::size_t> &rows, SortKey key,
+                bool descending, std::size_t top,
+                std::vector<std::size_t> &order);
+
+  std::vector<int> pid_;
+  std::vector<char> thread_;
+  std::size_t threads_{0};
+  std::vector<float> cpu_;
+  std::vector<long int> uptime_;
+  std::vector<unsigned long long> vsz_;
+  std::vector<unsigned long long> rss_;
+  std::vector<Text> user_;
+  std::vector<Text> command_;
+  // the distinct strings, one after the other.
+  std::vector<char> text_;
+  // strings already in text_ since Clear, by handle: equal handles are
+  // equal strings, there's no string to hash.
+  std::unordered_map<StringPool::Handle, Text, StringPool::Handle::Hash>
+      texts_;
+  std::vector<std::size_t> order_;
+  // keys of the last sort, kept for reusing the memory.
+  std::vector<std::pair<double, std::size_t>> numeric_keys_;
+  std::vector<std::pair<std::string_view, std::size_t>> text_keys_;
+  std::vector<std::size_t> roots_;
+  std::vector<std::size_t> children_;
+};
+
+#endif
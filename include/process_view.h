@@ -0,0 +1,113 @@
+#ifndef PROCESS_VIEW_H
+#define PROCESS_VIEW_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "process_table.h"
+
+/**
+ * @brief ProcessView is what the user looks at in the process table: the
+ * sort order, the search and the rows scrolled on the screen.
+ * It keeps its own copy of the last snapshot, so changing the order or the
+ * search doesn't wait for the next refresh.
+ */
+class ProcessView final {
+public:
+  /**
+   * @brief Construct a new ProcessView, ordered by cpu usage.
+   *
+   * @param height number of rows on the screen.
+   */
+  explicit ProcessView(std::size_t height);
+  /**
+   * @brief Update copies the processes of a new snapshot, keeping the
+   * order, the search and the scroll.
+   *
+   * @param processes table of the snapshot.
+   */
+  void Update(const ProcessTable &processes);
+  /**
+   * @brief SortBy orders the rows by a column, the largest values first for
+   * the numeric ones. Choosing the current column again reverses the order.
+   *
+   * @param key column to order by.
+   */
+  void SortBy(SortKey key);
+  /**
+   * @brief Search shows only the processes whose command or user contains
+   * the query, empty for all of them.
+   *
+   * @param query text to look for.
+   */
+  void Search(const std::string &query);
+  /**
+   * @brief ScrollBy moves the first visible row, within the rows.
+   *
+   * @param rows positive for moving down.
+   */
+  void ScrollBy(long rows);
+  /**
+   * @brief ScrollTo moves to a row, the last rows stay on the screen.
+   *
+   * @param offset first visible row.
+   */
+  void ScrollTo(std::size_t offset);
+  /**
+   * @brief SetHeight changes the number of rows on the screen, i.e. when
+   * the terminal is resized.
+   *
+   * @param height number of rows on the screen.
+   */
+  void SetHeight(std::size_t height);
+
+  SortKey Key() const noexcept { return key_; }
+  bool Descending() const noexcept { return descending_; }
+  const std::string &Query() const noexcept { return query_; }
+  std::size_t Height() const noexcept { return height_; }
+  /**
+   * @brief Offset returns the index of the first visible row.
+   *
+   * @return std::size_t offset in the matching rows.
+   */
+  std::size_t Offset() const noexcept { return offset_; }
+  /**
+   * @brief Size returns the number of rows matching the search.
+   *
+   * @return std::size_t matching rows.
+   */
+  std::size_t Size() const noexcept { return rows_.size(); }
+  /**
+   * @brief Visible returns the number of rows on the screen.
+   *
+   * @return std::size_t at most the height.
+   */
+  std::size_t Visible() const noexcept;
+  /**
+   * @brief Row returns the row of the table shown at a line of the screen.
+   *
+   * @param line in [0, Visible()).
+   * @return std::size_t row of Table().
+   */
+  std::size_t Row(std::size_t line) const noexcept {
+    return rows_[offset_ + line];
+  }
+  const ProcessTable &Table() const noexcept { return table_; }
+
+private:
+  // sort the table (up to the last visible row) and apply the search.
+  void Order();
+  // keep the offset within the rows.
+  void Clamp() noexcept;
+
+  ProcessTable table_;
+  std::vector<std::size_t> rows_;
+  SortKey key_{SortKey::kCpu};
+  bool descending_{true};
+  std::string query_;
+  std::size_t height_;
+  std::size_t offset_{0};
+};
+
+#endif
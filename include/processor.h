@@ -3,6 +3,8 @@
 #include <fstream>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 // forward declaration
@@ -23,8 +25,8 @@ public:
 
 private:
   static std::optional<Processor> CreateProcessor(std::ifstream &stream);
-  static std::tuple<std::string, std::string>
-  ParseLine(const std::string &line);
+  static std::pair<std::string_view, std::string_view>
+  ParseLine(std::string_view line);
 };
 /**
  * @brief Processor is a class that models a single core.
@@ -62,7 +64,8 @@ public:
    */
   std::string ModelName() const;
   /**
-   * @brief Utilization does sampling and return current utilization
+   * @brief Utilization returns the current utilization without blocking,
+   * the sampling is done by a background thread (LinuxParser::CPUMonitor).
    *
    * @return float the median of sampled utilization values
    */
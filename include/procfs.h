@@ -0,0 +1,92 @@
+#ifndef PROCFS_H
+#define PROCFS_H
+
+#include <sys/types.h>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace LinuxParser {
+/**
+ * @brief ProcFs reads the small files of /proc with raw syscalls.
+ * std::ifstream costs a locale, a buffer and several syscalls for each file,
+ * here we do openat + pread + close into a buffer owned by the calling
+ * thread and reused by every read. /proc is opened once, and the
+ * directories of the processes are kept open across refreshes (within a
+ * budget of file descriptors) so reading a process file costs no path
+ * lookup of /proc/PID.
+ */
+class ProcFs final {
+public:
+  /**
+   * @brief ProcDir returns the descriptor of /proc, opened once.
+   *
+   * @return int the descriptor, -1 if /proc is not available.
+   */
+  static int ProcDir();
+  /**
+   * @brief Read a whole file.
+   *
+   * @param dirfd descriptor of the directory for relative paths (or
+   * AT_FDCWD)
+   * @param path  path of the file, relative to dirfd.
+   * @return std::optional<std::string_view> the content, valid until the
+   * next read of the same thread; std::nullopt if the file can't be read.
+   */
+  static std::optional<std::string_view> Read(int dirfd, const char *path);
+  /**
+   * @brief Read a file of /proc, i.e. Read("meminfo").
+   *
+   * @param name path relative to /proc
+   * @return std::optional<std::string_view> the content, valid until the
+   * next read of the same thread.
+   */
+  static std::optional<std::string_view> Read(const char *name);
+  /**
+   * @brief Read a file of a process, i.e. ReadPid(1, "stat").
+   * The directory of the process is cached, if the cached one refers to a
+   * process that has exited (or whose pid has been reused) it's reopened.
+   *
+   * @param pid  process id
+   * @param name file name in /proc/PID
+   * @return std::optional<std::string_view> the content, valid until the
+   * next read of the same thread; std::nullopt if the process is gone, errno
+   * tells why (ENOENT if there is no such file or process, ESRCH if the
+   * process has exited while we were reading it).
+   */
+  static std::optional<std::string_view> ReadPid(int pid, const char *name);
+  /**
+   * @brief Pids lists the processes reading the entries of /proc with
+   * getdents64 on the descriptor of ProcDir, in a large buffer. The entries
+   * are filtered by d_type and by name, without any stat or allocation for
+   * each entry.
+   *
+   * @return std::vector<pid_t> sorted pids, empty if /proc can't be read.
+   */
+  static std::vector<pid_t> Pids();
+  /**
+   * @brief Tids lists the threads of a process, from /proc/PID/task, in the
+   * same way of Pids.
+   *
+   * @param pid process id
+   * @return std::vector<pid_t> sorted thread ids, empty if the process is
+   * gone.
+   */
+  static std::vector<pid_t> Tids(int pid);
+  /**
+   * @brief Close the cached directories of the processes that are not in
+   * the list anymore.
+   *
+   * @param pids sorted list of the current pids.
+   */
+  static void RetainPids(const std::vector<int> &pids);
+  /**
+   * @brief CachedPids returns how many process directories are open.
+   *
+   * @return std::size_t number of open directories.
+   */
+  static std::size_t CachedPids();
+};
+} // namespace LinuxParser
+#endif
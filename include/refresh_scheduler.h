@@ -0,0 +1,140 @@
+#ifndef REFRESH_SCHEDULER_H
+#define REFRESH_SCHEDULER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Phases of a refresh measured by the scheduler.
+ */
+enum class RefreshPhase { kSystem, kProcesses, kThreads, kRender };
+
+/**
+ * @brief RefreshScheduler keeps the cost of the monitor within a budget.
+ * The refreshes measure their phases, from the cost the scheduler derives:
+ *  - the interval between two refreshes, long enough for keeping the
+ *    monitor under its share of a cpu;
+ *  - how often the data that seldom changes (users, cpu topology, command
+ *    lines) is read again;
+ *  - how often the idle processes are sampled, the active ones are sampled
+ *    at every refresh.
+ * The strides grow while a frame costs more than its budget and shrink when
+ * it's well below.
+ */
+class RefreshScheduler final {
+public:
+  using Duration = std::chrono::nanoseconds;
+  /**
+   * @brief Limits that the monitor shall respect.
+   */
+  struct Budget {
+    // cost of a whole refresh (collection and rendering).
+    std::chrono::milliseconds frame{50};
+    // fraction of a single cpu used by the monitor.
+    double cpu_share{0.01};
+    std::chrono::milliseconds min_interval{1000};
+    std::chrono::milliseconds max_interval{10000};
+  };
+  /**
+   * @brief Weight of the last measure in the average cost of a phase.
+   */
+  static constexpr double COST_ALPHA{0.3};
+  /**
+   * @brief Refreshes between two reads of the slow data, within the budget.
+   */
+  static constexpr unsigned int SLOW_DATA_STRIDE{10};
+  /**
+   * @brief Refreshes without cpu time after which a process is idle.
+   */
+  static constexpr unsigned int IDLE_REFRESHES{3};
+  /**
+   * @brief Upper bound of the strides.
+   */
+  static constexpr unsigned int MAX_STRIDE{64};
+
+  RefreshScheduler();
+  explicit RefreshScheduler(Budget budget);
+  /**
+   * @brief Record the duration of a phase of the current refresh.
+   *
+   * @param phase
+   * @param duration
+   */
+  void Record(RefreshPhase phase, Duration duration) noexcept;
+  /**
+   * @brief Cost average cost of a phase.
+   *
+   * @param phase
+   * @return Duration
+   */
+  Duration Cost(RefreshPhase phase) const noexcept;
+  /**
+   * @brief FrameCost average cost of a whole refresh.
+   *
+   * @return Duration sum of the phases.
+   */
+  Duration FrameCost() const noexcept;
+  /**
+   * @brief Interval time to wait between two refreshes.
+   *
+   * @return std::chrono::milliseconds
+   */
+  std::chrono::milliseconds Interval() const noexcept;
+  /**
+   * @brief EndRefresh adapts the strides to the cost and moves to the next
+   * refresh.
+   */
+  void EndRefresh() noexcept;
+  /**
+   * @brief SlowDataDue tells if the slow data shall be read in this refresh.
+   *
+   * @return true in the first refresh and once every SlowDataStride.
+   */
+  bool SlowDataDue() const noexcept;
+  /**
+   * @brief SampleDue tells if an idle process shall be sampled in this
+   * refresh. The processes are spread on the refreshes by pid.
+   *
+   * @param pid process id
+   * @return true if the process shall be read.
+   */
+  bool SampleDue(int pid) const noexcept;
+  unsigned int SlowDataStride() const noexcept { return slow_stride_; }
+  unsigned int IdleStride() const noexcept { return idle_stride_; }
+  std::uint64_t Refreshes() const noexcept { return refreshes_; }
+  const Budget &Limits() const noexcept { return budget_; }
+
+  /**
+   * @brief Measure records the time from its creation to its destruction.
+   */
+  class Measure final {
+  public:
+    Measure(RefreshScheduler &scheduler, RefreshPhase phase)
+        : scheduler_(scheduler), phase_(phase),
+          start_(std::chrono::steady_clock::now()) {}
+    Measure(const Measure &) = delete;
+    Measure &operator=(const Measure &) = delete;
+    ~Measure() {
+      scheduler_.Record(phase_, std::chrono::steady_clock::now() - start_);
+    }
+
+  private:
+    RefreshScheduler &scheduler_;
+    RefreshPhase phase_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+private:
+  static constexpr std::size_t PHASES{4};
+
+  Budget budget_;
+  std::array<double, PHASES> cost_ns_{};
+  std::array<bool, PHASES> measured_{};
+  unsigned int slow_stride_{SLOW_DATA_STRIDE};
+  unsigned int idle_stride_{1};
+  std::uint64_t refreshes_{0};
+};
+
+#endif
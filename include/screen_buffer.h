@@ -0,0 +1,117 @@
+#ifndef SCREEN_BUFFER_H
+#define SCREEN_BUFFER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief ScreenBuffer is a shadow copy of the cells of a window.
+ * A frame is written in the back buffer, then Flush compares it with the
+ * front buffer (what the terminal shows) and draws only the cells that
+ * changed, grouped in runs of the same color. The output of a frame scales
+ * with what has changed, not with the size of the window.
+ * The cells of the border, if any, are never written: they belong to the
+ * box of the window.
+ */
+class ScreenBuffer final {
+public:
+  /**
+   * @brief Construct a new ScreenBuffer, the terminal is assumed blank.
+   *
+   * @param rows
+   * @param columns
+   * @param border width of the border around the cells that can be written.
+   */
+  ScreenBuffer(int rows, int columns, int border = 0);
+  int Rows() const noexcept { return rows_; }
+  int Columns() const noexcept { return columns_; }
+  int Border() const noexcept { return border_; }
+  /**
+   * @brief Resize the buffer, everything inside the border is drawn again
+   * by the next Flush.
+   *
+   * @param rows
+   * @param columns
+   */
+  void Resize(int rows, int columns);
+  /**
+   * @brief Clear blanks the back buffer, before writing a frame.
+   */
+  void Clear() noexcept;
+  /**
+   * @brief Invalidate forgets what the terminal shows, i.e. after it has
+   * been cleared: the next Flush draws every cell inside the border.
+   */
+  void Invalidate() noexcept;
+  /**
+   * @brief Put writes a text in the back buffer, clipped to the inside of
+   * the border.
+   *
+   * @param row
+   * @param column
+   * @param text
+   * @param width  the text is truncated or padded with blanks to width,
+   * negative for the length of the text.
+   * @param color  color pair of the cells, 0 for the default one.
+   */
+  void Put(int row, int column, std::string_view text, int width = -1,
+           short color = 0) noexcept;
+  /**
+   * @brief Flush draws the changed cells and makes the back buffer the
+   * front one.
+   *
+   * @param draw function called for each run of changed cells with the
+   * same color: draw(row, column, text, length, color).
+   * @return std::size_t number of cells drawn.
+   */
+  template <typename Draw> std::size_t Flush(Draw &&draw);
+
+private:
+  std::size_t Index(int row, int column) const noexcept {
+    return static_cast<std::size_t>(row) * columns_ + column;
+  }
+
+  int rows_{0};
+  int columns_{0};
+  int border_{0};
+  // characters and colors of the cells, row by row.
+  std::vector<char> back_;
+  std::vector<short> back_colors_;
+  std::vector<char> front_;
+  std::vector<short> front_colors_;
+};
+
+template <typename Draw> std::size_t ScreenBuffer::Flush(Draw &&draw) {
+  std::size_t drawn{0};
+  for (int row = 0; row < rows_; ++row) {
+    int column = 0;
+    while (column < columns_) {
+      auto cell = Index(row, column);
+      if (back_[cell] == front_[cell] &&
+          back_colors_[cell] == front_colors_[cell]) {
+        ++column;
+        continue;
+      }
+      // extend the run while the cells change and keep the color.
+      auto color = back_colors_[cell];
+      int end = column + 1;
+      for (; end < columns_; ++end) {
+        auto next = Index(row, end);
+        if (back_colors_[next] != color || (back_[next] == front_[next] &&
+                                            front_colors_[next] == color)) {
+          break;
+        }
+      }
+      int length = end - column;
+      draw(row, column, &back_[cell], length, color);
+      drawn += length;
+      column = end;
+    }
+  }
+  front_ = back_;
+  front_colors_ = back_colors_;
+  return drawn;
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+#include "process_table.h"
+
+/**
+ * @brief Snapshot is everything the display draws, captured by a single
+ * refresh. It's immutable once published: the renderer reads it while the
+ * collector fills the next one.
+ */
+struct Snapshot {
+  // incremented by each refresh, tells the renderer that something changed.
+  std::uint64_t sequence{0};
+  std::string operating_system;
+  std::string kernel;
+  float cpu_utilization{0.0f};
+  float memory_utilization{0.0f};
+  int total_processes{0};
+  int running_processes{0};
+  long int uptime{0};
+  ProcessTable processes;
+};
+
+#endif
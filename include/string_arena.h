@@ -0,0 +1,58 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief StringArena stores strings in large blocks and hands out views on
+ * them. Equal strings are stored once, so the views can be compared by
+ * pointer. Nothing is freed until Clear, that makes all the views invalid
+ * and keeps the blocks for the next fill.
+ */
+class StringArena final {
+public:
+  /**
+   * @brief Size of a block, longer strings get a block of their own.
+   */
+  static constexpr std::size_t BLOCK_SIZE{16 * 1024};
+  StringArena() = default;
+  StringArena(const StringArena &) = delete;
+  StringArena &operator=(const StringArena &) = delete;
+  /**
+   * @brief Intern copies a string in the arena, unless it's already there.
+   *
+   * @param value string to be stored.
+   * @return std::string_view view on the stored string, valid until Clear.
+   */
+  std::string_view Intern(std::string_view value);
+  /**
+   * @brief Clear forgets all the strings, the memory is reused.
+   */
+  void Clear() noexcept;
+  /**
+   * @brief Size returns the number of distinct strings stored.
+   *
+   * @return std::size_t number of strings.
+   */
+  std::size_t Size() const noexcept;
+
+private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t capacity;
+  };
+  // room for size bytes, in the current block or in the next one.
+  char *Allocate(std::size_t size);
+
+  std::vector<Block> blocks_;
+  // block being filled and bytes used in it.
+  std::size_t current_{0};
+  std::size_t used_{0};
+  std::unordered_set<std::string_view> strings_;
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "string_arena.h"
+
+/**
+ * @brief StringPool interns the strings shared by many processes (users,
+ * commands of worker pools): each distinct string is stored once in an
+ * arena and the processes keep a handle on it, equal handles mean equal
+ * strings.
+ * The strings are collected by generation: the owner starts a generation
+ * at each refresh, marks the handles still in use and sweeps the others.
+ * When most of the arena is garbage the live strings are moved in a new
+ * one, the handles stay valid.
+ * Intern can be called by many threads, Mark, Sweep and NextGeneration only
+ * by the owner while nobody else uses the pool. A worker interning many
+ * strings goes through a Cache of its own, so that it seldom locks the pool.
+ */
+class StringPool final {
+  struct Entry {
+    std::string_view text;
+    std::uint64_t generation{0};
+  };
+
+public:
+  /**
+   * @brief Handle of an interned string, it's as cheap to copy and to
+   * compare as a pointer.
+   */
+  class Handle final {
+  public:
+    Handle() = default;
+    std::string_view View() const noexcept {
+      return entry_ != nullptr ? entry_->text : std::string_view{};
+    }
+    bool operator==(Handle other) const noexcept {
+      return entry_ == other.entry_;
+    }
+    bool operator!=(Handle other) const noexcept {
+      return entry_ != other.entry_;
+    }
+    /**
+     * @brief Hash of a handle, for the maps keyed by interned string.
+     */
+    struct Hash {
+      std::size_t operator()(Handle handle) const noexcept {
+        return std::hash<const Entry *>{}(handle.entry_);
+      }
+    };
+
+  private:
+    friend StringPool;
+    explicit Handle(Entry *entry) : entry_(entry) {}
+    Entry *entry_{nullptr};
+  };
+  /**
+   * @brief Cache is the front of the pool for a single thread: a string it
+   * has already interned is found again without locking the pool. It
+   * forgets everything at each NextGeneration and Sweep of the pool.
+   */
+  class Cache final {
+  public:
+    explicit Cache(StringPool &pool) : pool_(&pool) {}
+    /**
+     * @brief Intern a string in the pool, it's locked only the first time
+     * in a generation.
+     *
+     * @param text string to be interned.
+     * @return Handle handle of the stored string.
+     */
+    Handle Intern(std::string_view text);
+
+  private:
+    StringPool *pool_;
+    // epoch of the pool when the handles have been interned.
+    std::uint64_t epoch_{0};
+    // the keys are views in the arena of the pool.
+    std::unordered_map<std::string_view, Handle> handles_;
+  };
+  /**
+   * @brief Minimum number of dead strings before compacting the arena.
+   */
+  static constexpr std::size_t MIN_GARBAGE{256};
+
+  StringPool();
+  StringPool(const StringPool &) = delete;
+  StringPool &operator=(const StringPool &) = delete;
+  /**
+   * @brief Shared returns a pool that is never swept, for the processes
+   * built outside of a System.
+   *
+   * @return StringPool& the shared pool.
+   */
+  static StringPool &Shared();
+  /**
+   * @brief Intern a string and mark it as used in the current generation.
+   *
+   * @param text string to be interned.
+   * @return Handle handle of the stored string.
+   */
+  Handle Intern(std::string_view text);
+  /**
+   * @brief NextGeneration starts a new generation, the strings not interned
+   * or marked from now on are swept by the next Sweep.
+   */
+  void NextGeneration() noexcept;
+  /**
+   * @brief Mark a string as used in the current generation.
+   *
+   * @param handle handle returned by Intern.
+   */
+  void Mark(Handle handle) noexcept;
+  /**
+   * @brief Sweep drops the strings not used in the current generation, their
+   * handles must not be used anymore.
+   */
+  void Sweep();
+  /**
+   * @brief Size returns the number of live strings.
+   *
+   * @return std::size_t number of strings.
+   */
+  std::size_t Size() const;
+
+private:
+  // move the live strings in a new arena.
+  void Compact();
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<StringArena> arena_;
+  // entries never move, the handles point to them.
+  std::deque<Entry> entries_;
+  std::vector<Entry *> free_;
+  // interned strings by content, the keys are views in the arena: an empty
+  // string has no address of its own.
+  std::unordered_map<std::string_view, Entry *> index_;
+  std::uint64_t generation_{1};
+  // changed by NextGeneration and Sweep: the caches are stale.
+  std::uint64_t epoch_{1};
+};
+
+#endif
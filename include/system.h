@@ -1,14 +1,43 @@
 #ifndef SYSTEM_H
 #define SYSTEM_H
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "cpu_topology.h"
+#include "cpu_usage_tracker.h"
 #include "process.h"
+#include "process_table.h"
 #include "processor.h"
+#include "refresh_scheduler.h"
+#include "system_stat.h"
+#include "thread_pool.h"
 
 class System {
 public:
+  /**
+   * @brief Number of consecutive pids built by a worker at once.
+   */
+  static constexpr std::size_t PROCESSES_PER_TASK{32};
+  /**
+   * @brief Counters of the last refresh of the processes.
+   */
+  struct RefreshStats {
+    // new processes read from scratch.
+    std::size_t built{0};
+    // processes of the previous refresh that have been updated.
+    std::size_t updated{0};
+    // processes (and threads) that exited or could not be read during the
+    // refresh.
+    std::size_t dropped{0};
+    // threads read in threads mode.
+    std::size_t threads{0};
+    // idle processes whose sample has been skipped, counted as updated.
+    std::size_t skipped{0};
+  };
   /**
    * @brief Construct a new System
    * Load everything that it is immutable just once. Immutable things are:
@@ -16,15 +45,89 @@ public:
    *  - Operating System
    *  - Kernel Version.
    * Other things are loaded whenever the method is called.
+   *
+   * @param workers number of threads building the processes, 0 for one per
+   * online cpu.
    */
-  System();
+  explicit System(std::size_t workers = 0);
+  /**
+   * @brief Refresh captures the per tick data shared by all the queries,
+   * i.e. /proc/stat is read and the pids are listed here once and not for
+   * each query.
+   * It shall be called at the beginning of each refresh.
+   */
+  void Refresh();
   /**
    * @brief  Cpu return current processor descriptor (first core in the system)
    *
    * @return Processor&
    */
   Processor &Cpu();
-  std::vector<Process> &Processes(); // TODO: See src/system.cpp
+  /**
+   * @brief Topology returns the layout of the cpus in the system.
+   *
+   * @return const CpuTopology& cores, sockets and NUMA nodes.
+   */
+  const CpuTopology &Topology() const;
+  /**
+   * @brief RefreshTopology detects again the cpus after a hotplug.
+   */
+  void RefreshTopology();
+  /**
+   * @brief CoreUtilization returns the utilization of each online core.
+   *
+   * @return std::vector<float> utilization fraction (0-1) of each core.
+   */
+  std::vector<float> CoreUtilization() const;
+  /**
+   * @brief Processes refreshes the processes listed by the last Refresh.
+   * Only the new processes are built from scratch, the others update the
+   * values that change (cpu and memory).
+   *
+   * @return std::vector<Process>& processes sorted by pid.
+   */
+  std::vector<Process> &Processes();
+  /**
+   * @brief Table returns the processes of the last call of Processes in
+   * columns, in pid order: the display sorts its own copy.
+   *
+   * @return const ProcessTable& processes sorted by pid.
+   */
+  const ProcessTable &Table() const;
+  /**
+   * @brief SetThreadsMode enables the threads of the processes (from
+   * /proc/PID/task) in the table, each one under its process with its own
+   * cpu usage. It's applied from the next call of Processes.
+   *
+   * @param enabled true for showing the threads.
+   */
+  void SetThreadsMode(bool enabled);
+  /**
+   * @brief ThreadsMode tells if the threads are collected.
+   *
+   * @return true if the threads are in the table.
+   */
+  bool ThreadsMode() const;
+  /**
+   * @brief LastRefreshStats tells how the last call of Processes went.
+   *
+   * @return const RefreshStats& counters of the last refresh.
+   */
+  const RefreshStats &LastRefreshStats() const;
+  /**
+   * @brief Scheduler measures the phases of the refresh, the display records
+   * the rendering there too.
+   *
+   * @return RefreshScheduler& scheduler of the refreshes.
+   */
+  RefreshScheduler &Scheduler();
+  /**
+   * @brief RefreshInterval tells how long to wait before the next refresh,
+   * so that refreshing stays within its cpu budget.
+   *
+   * @return std::chrono::milliseconds the interval until the next refresh.
+   */
+  std::chrono::milliseconds RefreshInterval() const;
   float MemoryUtilization();         // TODO: See src/system.cpp
   /**
    * @brief Uptime returns current system uptime
@@ -60,12 +163,18 @@ public:
 
   // TODO: Define any necessary private members
 private:
-  // Load the number of processes in the CPU.
-  int LoadRunningProcessing();
   // Load the current operating system
   void DetectOperatingSystem();
   // Load the current kernel version
   void DetectKernelVersion();
+  // Load the descriptor of the cpu
+  void DetectCpu();
+  // Merge pids_ with processes_ and read the processes that changed.
+  void UpdateProcesses();
+  // Build the threads of processes_ in threads_, in threads mode.
+  void CollectThreads();
+  // Compute the cpu usage and copy processes_ and threads_ in table_.
+  void FillTable();
   // uptime in seconds
 
   long int uptime_{0};
@@ -78,7 +187,31 @@ private:
   // operating system
   std::string operating_system_;
   Processor cpu_ = {};
+  // shared cpu topology, detected once.
+  std::shared_ptr<const CpuTopology> topology_;
+  // users and commands of the processes, declared before them.
+  StringPool strings_;
   std::vector<Process> processes_ = {};
+  // /proc/stat captured by the last refresh.
+  LinuxParser::SystemStatSnapshot system_stat_ = {};
+  // sorted pids listed by the last refresh.
+  std::vector<int> pids_;
+  // per process cpu time of the previous refresh.
+  CpuUsageTracker cpu_tracker_;
+  // threads mode: threads sorted by tgid and tid, and their cpu time.
+  bool threads_mode_{false};
+  std::vector<Process> threads_;
+  CpuUsageTracker thread_tracker_;
+  // workers building the processes, each one with its output buffer.
+  ThreadPool pool_;
+  std::vector<std::vector<Process>> buffers_;
+  // front of strings_ for each worker.
+  std::vector<StringPool::Cache> caches_;
+  RefreshStats refresh_stats_;
+  // columnar copy of processes_ read by the display.
+  ProcessTable table_;
+  // cost of the refreshes, interval and strides of the slow data.
+  RefreshScheduler scheduler_;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#ifndef SYSTEM_STAT_H
+#define SYSTEM_STAT_H
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace LinuxParser {
+/**
+ * @brief CpuTimes are the jiffies of a cpu line in /proc/stat.
+ */
+struct CpuTimes {
+  /**
+   * @brief Total time spent by the cpu.
+   * guest and guest_nice are already accounted in user and nice, so like
+   * htop does we don't count them twice.
+   *
+   * @return unsigned long long total jiffies.
+   */
+  unsigned long long Total() const noexcept {
+    return user + nice + system + idle + iowait + irq + softirq + steal;
+  }
+  /**
+   * @brief Time spent by the cpu doing nothing or waiting for I/O.
+   *
+   * @return unsigned long long idle jiffies.
+   */
+  unsigned long long IdleAll() const noexcept { return idle + iowait; }
+
+  unsigned long long user{0};
+  unsigned long long nice{0};
+  unsigned long long system{0};
+  unsigned long long idle{0};
+  unsigned long long iowait{0};
+  unsigned long long irq{0};
+  unsigned long long softirq{0};
+  unsigned long long steal{0};
+  unsigned long long guest{0};
+  unsigned long long guest_nice{0};
+};
+
+/**
+ * @brief CoreTimes are the jiffies of all the cpuN lines in /proc/stat,
+ * stored as a structure of arrays: the i-th element of each array belongs to
+ * the i-th core, so per core computations run over contiguous memory.
+ */
+struct CoreTimes {
+  /**
+   * @brief Size returns the number of cores.
+   *
+   * @return std::size_t number of cores.
+   */
+  std::size_t Size() const noexcept { return id.size(); }
+
+  // cpu number, offline cpus are missing in /proc/stat.
+  std::vector<unsigned int> id;
+  std::vector<unsigned long long> user;
+  std::vector<unsigned long long> nice;
+  std::vector<unsigned long long> system;
+  std::vector<unsigned long long> idle;
+  std::vector<unsigned long long> iowait;
+  std::vector<unsigned long long> irq;
+  std::vector<unsigned long long> softirq;
+  std::vector<unsigned long long> steal;
+};
+
+/**
+ * @brief SystemStatSnapshot is the content of /proc/stat at a given time.
+ * It's captured once for each refresh and passed around by const reference.
+ */
+struct SystemStatSnapshot {
+  // aggregate "cpu" line
+  CpuTimes cpu;
+  // "cpuN" lines, in the order of the file.
+  CoreTimes cores;
+  unsigned long long ctxt{0};
+  unsigned long long btime{0};
+  unsigned long long processes{0};
+  unsigned long long procs_running{0};
+  unsigned long long procs_blocked{0};
+  // first value of the intr and softirq lines, the total count.
+  unsigned long long intr{0};
+  unsigned long long softirq{0};
+};
+
+/**
+ * @brief Parse the content of /proc/stat.
+ *
+ * @param content content of the file.
+ * @return std::optional<SystemStatSnapshot> std::nullopt if the aggregate
+ * cpu line is missing.
+ */
+std::optional<SystemStatSnapshot> ParseSystemStat(std::string_view content);
+
+/**
+ * @brief Compute the utilization of each core between two snapshots.
+ * If the cores are not the same in both snapshots (i.e. after a hotplug)
+ * the utilization is zero until the next snapshot.
+ *
+ * @param previous  cores of the previous snapshot
+ * @param current   cores of the current snapshot
+ * @param utilization output, the busy fraction (0-1) of each current core.
+ */
+void CoreUtilization(const CoreTimes &previous, const CoreTimes &current,
+                     std::vector<float> &utilization);
+
+/**
+ * @brief Read /proc/stat and parse it.
+ *
+ * @return std::optional<SystemStatSnapshot> std::nullopt if the file cannot
+ * be read or parsed.
+ */
+std::optional<SystemStatSnapshot> ReadSystemStat();
+} // namespace LinuxParser
+#endif
@@ -0,0 +1,89 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief ThreadPool runs the iterations of a loop on a fixed set of workers.
+ * The index range is cut in chunks that are dealt to the workers in
+ * contiguous blocks; a worker takes the chunks from the front of its own
+ * queue and, when it's empty, steals from the back of the others. So a
+ * worker stuck on slow items (i.e. a process with a huge status) doesn't
+ * leave the others idle.
+ */
+class ThreadPool final {
+public:
+  /**
+   * @brief Body of a loop: the index of the item and the index of the worker
+   * running it, in [0, Size()), for writing in per worker buffers.
+   */
+  using Body = std::function<void(std::size_t index, std::size_t worker)>;
+  /**
+   * @brief Construct a new ThreadPool and start the workers.
+   *
+   * @param workers number of threads, at least one.
+   */
+  explicit ThreadPool(std::size_t workers);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  /**
+   * @brief Destroy the ThreadPool, waiting for the workers.
+   */
+  ~ThreadPool();
+  /**
+   * @brief Size returns the number of workers.
+   *
+   * @return std::size_t number of workers.
+   */
+  std::size_t Size() const noexcept;
+  /**
+   * @brief ParallelFor runs body for each index in [0, count) and waits for
+   * all of them. Only one loop runs at a time, concurrent calls are
+   * serialized. The first exception thrown by body is rethrown here, once
+   * every worker is done.
+   *
+   * @param count number of iterations.
+   * @param grain number of consecutive indexes taken at once by a worker.
+   * @param body  function called for each index.
+   */
+  void ParallelFor(std::size_t count, std::size_t grain, const Body &body);
+
+private:
+  // half open range of indexes.
+  using Range = std::pair<std::size_t, std::size_t>;
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Range> ranges;
+  };
+  // loop of a worker.
+  void Run(std::size_t worker);
+  // run the chunks of the current loop until there is nothing to steal.
+  void Drain(std::size_t worker);
+  bool Pop(std::size_t worker, Range &range);
+  bool Steal(std::size_t worker, Range &range);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  // serializes the calls of ParallelFor.
+  std::mutex loop_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  // incremented for each loop, it wakes up the workers.
+  std::size_t generation_{0};
+  std::size_t busy_{0};
+  bool running_{true};
+  const Body *body_{nullptr};
+  std::exception_ptr error_;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef USER_DIRECTORY_H
+#define USER_DIRECTORY_H
+
+#include <sys/types.h>
+
+#include <ctime>
+#include <filesystem>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief UserDirectory maps uids to user names.
+ * It loads /etc/passwd once in a flat vector sorted by uid and reloads it
+ * only when the file changes (inode, size or modification time), so
+ * looking up the user of a process doesn't touch the filesystem.
+ */
+class UserDirectory final {
+public:
+  /**
+   * @brief Construct a new User Directory object and load the users.
+   *
+   * @param passwd path of the password database.
+   */
+  explicit UserDirectory(std::filesystem::path passwd);
+  /**
+   * @brief Instance returns the process wide directory for /etc/passwd.
+   *
+   * @return UserDirectory& the shared directory.
+   */
+  static UserDirectory &Instance();
+  /**
+   * @brief Reload the users if the password database has changed.
+   * It costs a stat(2) when nothing changed.
+   *
+   * @return true if the users have been reloaded.
+   */
+  bool Refresh();
+  /**
+   * @brief Find the user name for a uid.
+   *
+   * @param uid  user id to look for.
+   * @return std::string the user name, or the uid itself as ps does when
+   * the user is not in the database.
+   */
+  std::string Find(uid_t uid) const;
+  /**
+   * @brief Size returns the number of the known users.
+   *
+   * @return std::size_t number of users.
+   */
+  std::size_t Size() const;
+
+private:
+  struct User {
+    uid_t uid;
+    std::string name;
+  };
+  // parse the database content in a sorted vector.
+  static std::vector<User> Parse(std::string_view content);
+
+  std::filesystem::path passwd_;
+  ino_t inode_{0};
+  off_t size_{-1};
+  timespec mtime_{};
+  std::vector<User> users_;
+  mutable std::shared_mutex mutex_;
+};
+
+#endif
@@ -1,11 +1,18 @@
 #ifndef ND_UTIL_H
 #define ND_UTIL_H
 #include <algorithm>
+#include <charconv>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 
 /**
  * @brief This namespace has a useful string parsing functions
@@ -118,6 +125,176 @@ inline std::vector<std::string> split(const std::string &data, char sep) {
   return splitted_data;
 }
 
+/**
+ * @brief Trim whitespaces at the beginning of a view, without copying.
+ * @param value view to be trimmed.
+ * @return std::string_view the trimmed view.
+ */
+inline std::string_view ltrimmed(std::string_view value) noexcept {
+  auto start = value.find_first_not_of(WHITESPACE);
+  return (start == std::string_view::npos) ? std::string_view{}
+                                           : value.substr(start);
+}
+/**
+ * @brief Trim whitespaces at the end of a view, without copying.
+ * @param value view to be trimmed.
+ * @return std::string_view the trimmed view.
+ */
+inline std::string_view rtrimmed(std::string_view value) noexcept {
+  auto end = value.find_last_not_of(WHITESPACE);
+  return (end == std::string_view::npos) ? std::string_view{}
+                                         : value.substr(0, end + 1);
+}
+/**
+ * @brief Trim whitespaces at both ends of a view, without copying.
+ * @param value view to be trimmed.
+ * @return std::string_view the trimmed view.
+ */
+inline std::string_view trimmed(std::string_view value) noexcept {
+  return rtrimmed(ltrimmed(value));
+}
+/**
+ * @brief Split a view in two parts at the first of the chars, both parts are
+ * trimmed. It's the non allocating version of splitInTwo.
+ * @param str view to be splitted
+ * @param chars list of characters to be used.
+ * @return std::pair<std::string_view, std::string_view> the parts, the
+ * second is empty if no char has been found.
+ */
+inline std::pair<std::string_view, std::string_view>
+split_view(std::string_view str, std::string_view chars) noexcept {
+  auto mid = str.find_first_of(chars);
+  if (mid == std::string_view::npos) {
+    return {trimmed(str), {}};
+  }
+  return {trimmed(str.substr(0, mid)), trimmed(str.substr(mid + 1))};
+}
+/**
+ * @brief Tokenizer iterates over the tokens of a view divided by any of the
+ * separators. Empty tokens are skipped, like repeated spaces in /proc files.
+ * Tokens are views on the original data: nothing is copied or allocated.
+ *
+ * for (auto token : util::Tokenizer(line, " ")) { ... }
+ */
+class Tokenizer final {
+public:
+  class iterator final {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view *;
+    using reference = const std::string_view &;
+
+    iterator() = default;
+    iterator(std::string_view rest, std::string_view separators) noexcept
+        : rest_(rest), separators_(separators) {
+      ++(*this);
+    }
+    reference operator*() const noexcept { return token_; }
+    pointer operator->() const noexcept { return &token_; }
+    iterator &operator++() noexcept {
+      auto start = rest_.find_first_not_of(separators_);
+      if (start == std::string_view::npos) {
+        token_ = {};
+        rest_ = {};
+        done_ = true;
+        return *this;
+      }
+      rest_.remove_prefix(start);
+      auto end = std::min(rest_.find_first_of(separators_), rest_.size());
+      token_ = rest_.substr(0, end);
+      rest_.remove_prefix(end);
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      auto current = *this;
+      ++(*this);
+      return current;
+    }
+    bool operator==(const iterator &other) const noexcept {
+      return done_ == other.done_ &&
+             (done_ || token_.data() == other.token_.data());
+    }
+    bool operator!=(const iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+  private:
+    friend class Tokenizer;
+    std::string_view rest_;
+    std::string_view separators_;
+    std::string_view token_;
+    bool done_{false};
+  };
+  /**
+   * @brief Construct a new Tokenizer.
+   * @param data  view to be tokenized, it must outlive the tokenizer.
+   * @param separators characters dividing the tokens.
+   */
+  Tokenizer(std::string_view data, std::string_view separators) noexcept
+      : data_(data), separators_(separators) {}
+  iterator begin() const noexcept { return iterator(data_, separators_); }
+  iterator end() const noexcept {
+    iterator done;
+    done.done_ = true;
+    return done;
+  }
+  /**
+   * @brief Get the token at a position.
+   * @param index position of the token, starting from 0.
+   * @return std::string_view the token, empty if there are less tokens.
+   */
+  std::string_view at(std::size_t index) const noexcept {
+    for (auto token : *this) {
+      if (index-- == 0) {
+        return token;
+      }
+    }
+    return {};
+  }
+
+private:
+  std::string_view data_;
+  std::string_view separators_;
+};
+/**
+ * @brief Parse a number from a view with std::from_chars: no locale, no
+ * allocations and no exceptions. Whitespaces around the number are ignored.
+ *
+ * @tparam T integral or floating point type.
+ * @param data view to be parsed.
+ * @return std::optional<T> std::nullopt if it's not a number of type T.
+ */
+template <typename T> std::optional<T> parse(std::string_view data) noexcept {
+  data = trimmed(data);
+  T value{};
+  auto end = data.data() + data.size();
+  auto [ptr, ec] = std::from_chars(data.data(), end, value);
+  if (ec != std::errc() || ptr != end || data.empty()) {
+    return std::nullopt;
+  }
+  return value;
+}
+/**
+ * @brief Parse the number at the beginning of a view, i.e. "3072 KB".
+ *
+ * @tparam T integral or floating point type.
+ * @param data view to be parsed.
+ * @return std::optional<T> std::nullopt if it doesn't start with a number.
+ */
+template <typename T>
+std::optional<T> parse_prefix(std::string_view data) noexcept {
+  data = ltrimmed(data);
+  T value{};
+  auto [ptr, ec] =
+      std::from_chars(data.data(), data.data() + data.size(), value);
+  if (ec != std::errc() || data.empty()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
 /**
  * @brief Check if a string is an integer number and it could be converted.
  *
@@ -125,21 +302,23 @@ inline std::vector<std::string> split(const std::string &data, char sep) {
  * @return true  if it's a integral number
  * @return false if it's not an integral number
  */
-inline bool is_number(const std::string &data) {
+inline bool is_number(std::string_view data) noexcept {
   return ((!data.empty()) &&
-          (data.find_first_not_of(NUMBERS) == std::string::npos));
+          (data.find_first_not_of(NUMBERS) == std::string_view::npos));
 }
-inline int to_integral(const std::string &row) {
-  auto value(row);
-  ltrim(value);
-  rtrim(value);
-  return stoi(value);
+inline int to_integral(std::string_view row) {
+  auto value = parse<int>(row);
+  if (!value) {
+    throw std::invalid_argument("not an integral number");
+  }
+  return *value;
 }
-inline float to_float(const std::string &row) {
-  auto value(row);
-  ltrim(value);
-  rtrim(value);
-  return stof(value);
+inline float to_float(std::string_view row) {
+  auto value = parse<float>(row);
+  if (!value) {
+    throw std::invalid_argument("not a float number");
+  }
+  return *value;
 }
 /**
  * @brief Scan a directory applying a callback function to each element
@@ -154,7 +333,8 @@ inline void scan_pid(const std::string &path,
                      const std::function<void(std::string)> &op) {
   for (const auto &entry : std::filesystem::directory_iterator(path)) {
     auto pathname = entry.path();
-    if (entry.is_directory() && util::is_number(pathname.filename())) {
+    if (entry.is_directory() &&
+        util::is_number(pathname.filename().native())) {
       op(pathname.filename());
     }
   }
@@ -0,0 +1,105 @@
+#include "collector.h"
+
+Collector::Collector(System &system)
+    : system_(system), threads_mode_(system.ThreadsMode()) {}
+
+Collector::~Collector() { Stop(); }
+
+void Collector::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&Collector::Run, this);
+}
+
+void Collector::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void Collector::Collect() {
+  auto render = render_ns_.load(std::memory_order_relaxed);
+  if (render >= 0) {
+    system_.Scheduler().Record(RefreshPhase::kRender,
+                               std::chrono::nanoseconds(render));
+  }
+  system_.SetThreadsMode(threads_mode_.load(std::memory_order_relaxed));
+  system_.Refresh();
+  system_.Processes();
+  auto snapshot = Recycle();
+  snapshot->sequence = ++sequence_;
+  snapshot->operating_system = system_.OperatingSystem();
+  snapshot->kernel = system_.Kernel();
+  snapshot->cpu_utilization = system_.Cpu().Utilization();
+  snapshot->memory_utilization = system_.MemoryUtilization();
+  snapshot->total_processes = system_.TotalProcesses();
+  snapshot->running_processes = system_.RunningProcesses();
+  snapshot->uptime = system_.UpTime();
+  snapshot->processes.Assign(system_.Table());
+  std::atomic_store(&latest_, std::shared_ptr<const Snapshot>(snapshot));
+}
+
+std::shared_ptr<const Snapshot> Collector::Latest() const {
+  return std::atomic_load(&latest_);
+}
+
+void Collector::RecordRender(std::chrono::nanoseconds duration) noexcept {
+  render_ns_.store(duration.count(), std::memory_order_relaxed);
+}
+
+void Collector::Release(std::shared_ptr<const Snapshot> snapshot) {
+  // the latest can be taken again by Latest, it's not recycled. An older
+  // one never becomes the latest again until it's filled again.
+  if (snapshot == nullptr || snapshot == Latest()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(released_mutex_);
+  if (released_.size() < SNAPSHOTS) {
+    released_.emplace_back(std::move(snapshot));
+  }
+}
+
+void Collector::SetThreadsMode(bool enabled) {
+  threads_mode_.store(enabled, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refresh_now_ = true;
+  }
+  wake_.notify_all();
+}
+
+bool Collector::ThreadsMode() const noexcept {
+  return threads_mode_.load(std::memory_order_relaxed);
+}
+
+void Collector::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    refresh_now_ = false;
+    lock.unlock();
+    Collect();
+    lock.lock();
+    // woken up early by Stop or by a new mode.
+    wake_.wait_for(lock, system_.RefreshInterval(),
+                   [this] { return !running_ || refresh_now_; });
+  }
+}
+
+std::shared_ptr<Snapshot> Collector::Recycle() {
+  std::lock_guard<std::mutex> lock(released_mutex_);
+  if (released_.empty()) {
+    return std::make_shared<Snapshot>();
+  }
+  // created as mutable by this class, only published as const.
+  auto reused = std::const_pointer_cast<Snapshot>(std::move(released_.back()));
+  released_.pop_back();
+  return reused;
+}
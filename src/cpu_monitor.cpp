@@ -0,0 +1,127 @@
+#include "cpu_monitor.h"
+
+#include <algorithm>
+
+#include "cpu_sampler.h"
+#include "processor.h"
+
+namespace LinuxParser {
+
+CPUMonitor::CPUMonitor(std::chrono::milliseconds period, std::size_t window)
+    : window_(std::clamp<std::size_t>(window, 1, RING_SIZE)),
+      period_ms_(period.count()),
+      cores_(std::make_shared<const std::vector<float>>()) {}
+
+CPUMonitor::~CPUMonitor() { Stop(); }
+
+CPUMonitor &CPUMonitor::Instance() {
+  // same statistic that the CPUSampler computes, a median over
+  // Processor::CPU_SAMPLES samples, but never on the caller's thread.
+  static CPUMonitor monitor{
+      std::chrono::milliseconds(CPUSampler::SAMPLING_TIME_MS),
+      Processor::CPU_SAMPLES};
+  monitor.Start();
+  return monitor;
+}
+
+void CPUMonitor::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&CPUMonitor::Run, this);
+}
+
+void CPUMonitor::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  wakeup_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void CPUMonitor::SetPeriod(std::chrono::milliseconds period) noexcept {
+  period_ms_.store(period.count(), std::memory_order_relaxed);
+}
+
+float CPUMonitor::Median() const noexcept {
+  return median_.load(std::memory_order_acquire);
+}
+
+float CPUMonitor::Ema() const noexcept {
+  return ema_.load(std::memory_order_acquire);
+}
+
+float CPUMonitor::Latest() const noexcept {
+  auto head = head_.load(std::memory_order_acquire);
+  if (head == 0) {
+    return 0.0f;
+  }
+  return ring_[(head - 1) % RING_SIZE].load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<const std::vector<float>>
+CPUMonitor::CoreUtilization() const {
+  return std::atomic_load(&cores_);
+}
+
+std::uint64_t CPUMonitor::Samples() const noexcept {
+  return head_.load(std::memory_order_acquire);
+}
+
+void CPUMonitor::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    lock.unlock();
+    auto snapshot = ReadSystemStat();
+    if (snapshot != std::nullopt) {
+      const auto &current = snapshot->cpu;
+      if (previous_ != std::nullopt &&
+          current.Total() > previous_->Total()) {
+        auto total = current.Total() - previous_->Total();
+        auto idle = current.IdleAll() - previous_->IdleAll();
+        Push(100.0f * (total - std::min(idle, total)) / total);
+        auto cores = std::make_shared<std::vector<float>>();
+        LinuxParser::CoreUtilization(previous_cores_, snapshot->cores, *cores);
+        for (auto &core : *cores) {
+          core *= 100.0f;
+        }
+        std::atomic_store(&cores_,
+                          std::shared_ptr<const std::vector<float>>(cores));
+      }
+      previous_ = current;
+      previous_cores_ = std::move(snapshot->cores);
+    }
+    lock.lock();
+    wakeup_.wait_for(
+        lock,
+        std::chrono::milliseconds(period_ms_.load(std::memory_order_relaxed)),
+        [this] { return !running_; });
+  }
+}
+
+void CPUMonitor::Push(float value) noexcept {
+  auto head = head_.load(std::memory_order_relaxed);
+  ring_[head % RING_SIZE].store(value, std::memory_order_relaxed);
+  head_.store(head + 1, std::memory_order_release);
+  // only this thread writes, so the statistics are computed here once and
+  // readers just load them.
+  auto count = std::min<std::uint64_t>(head + 1, window_);
+  std::array<float, RING_SIZE> window;
+  for (std::uint64_t i = 0; i < count; ++i) {
+    window[i] = ring_[(head - i) % RING_SIZE].load(std::memory_order_relaxed);
+  }
+  auto middle = window.begin() + count / 2;
+  std::nth_element(window.begin(), middle, window.begin() + count);
+  median_.store(*middle, std::memory_order_release);
+  auto ema = (head == 0) ? value
+                         : EMA_ALPHA * value +
+                               (1.0f - EMA_ALPHA) *
+                                   ema_.load(std::memory_order_relaxed);
+  ema_.store(ema, std::memory_order_release);
+}
+} // namespace LinuxParser
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "linux_parser.h"
+#include "system_stat.h"
 
 namespace LinuxParser {
 
@@ -45,24 +46,6 @@ void CPUSampler::Sample() {
   auto median = data[pos];
   update_(median);
 }
-/**
- * @brief split the string to a vector (parse the string)
- * @param input string of counters with spaces (i.e 912 129 12 12)
- * @return std::vector<int> a vector of integer
- */
-std::vector<int> CPUSampler::Split(const std::string &input) const {
-  std::istringstream tokens(input);
-  std::vector<int> data;
-  while (tokens) {
-    int v{0};
-
-    tokens >> v;
-    if (tokens) {
-      data.emplace_back(v);
-    }
-  }
-  return data;
-}
 /**
  * @brief Load data from /proc/stat about CPU usage
  *  we return 0 when we cannot read the data.
@@ -70,33 +53,27 @@ std::vector<int> CPUSampler::Split(const std::string &input) const {
  * @return float
  */
 float CPUSampler::LoadData() const {
-  // build the correct file path before opening the file
-  std::filesystem::path dataPath(LinuxParser::kProcDirectory);
-  dataPath += "stat";
-  std::ifstream datafile{dataPath};
-  if (datafile.is_open()) {
-    std::string cpuValue;
-    std::getline(datafile, cpuValue);
-    cpuValue = cpuValue.substr(5);
-    auto data = Split(cpuValue);
-    // precondition shall be at least 7.
-    if (data.size() < 7) {
-      // this sampling has been not correct;
-      return 0.0;
-    }
-    /*  Those are the semantic of the values in the data array:
-        1st item : user = normal processes executing in user mode
-        2nd column : nice = niced processes executing in user mode
-        3rd column : system = processes executing in kernel mode
-        4th column : idle = twiddling thumbs
-        5th column : iowait = waiting for I/O to complete
-        6th column : irq = servicing interrupts
-        7th column : softirq = servicing softirqs
-    */
-    auto idle_percentuage =
-        (data[3] * 100.0) / std::accumulate(data.begin(), data.begin() + 7, 0);
-    return 100.0 - idle_percentuage;
+  auto snapshot = ReadSystemStat();
+  if (snapshot == std::nullopt) {
+    // this sampling has been not correct;
+    return 0.0;
+  }
+  /*  Those are the semantic of the values we use:
+      user = normal processes executing in user mode
+      nice = niced processes executing in user mode
+      system = processes executing in kernel mode
+      idle = twiddling thumbs
+      iowait = waiting for I/O to complete
+      irq = servicing interrupts
+      softirq = servicing softirqs
+  */
+  const auto &cpu = snapshot->cpu;
+  auto total = cpu.user + cpu.nice + cpu.system + cpu.idle + cpu.iowait +
+               cpu.irq + cpu.softirq;
+  if (total == 0) {
+    return 0.0;
   }
-  return 0.0;
+  auto idle_percentuage = (cpu.idle * 100.0) / total;
+  return 100.0 - idle_percentuage;
 }
 } // namespace LinuxParser
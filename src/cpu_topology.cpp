@@ -0,0 +1,131 @@
+#include "cpu_topology.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace {
+const std::filesystem::path kSysCpuDirectory{"/sys/devices/system/cpu"};
+const std::filesystem::path kSysNodeDirectory{"/sys/devices/system/node"};
+
+// read the first line of a sysfs attribute.
+std::string ReadAttribute(const std::filesystem::path &path) {
+  std::string value;
+  std::ifstream stream{path};
+  if (stream.is_open()) {
+    std::getline(stream, value);
+  }
+  return value;
+}
+
+int ReadNumber(const std::filesystem::path &path, int fallback) {
+  auto value = ReadAttribute(path);
+  int number{fallback};
+  std::from_chars(value.data(), value.data() + value.size(), number);
+  return number;
+}
+
+// the shared topology: replaced with atomic_store, read with atomic_load.
+std::shared_ptr<const CpuTopology> &SharedTopology() {
+  static std::shared_ptr<const CpuTopology> topology =
+      std::make_shared<const CpuTopology>(
+          CpuTopology::Detect(kSysCpuDirectory, kSysNodeDirectory));
+  return topology;
+}
+} // namespace
+
+std::shared_ptr<const CpuTopology> CpuTopology::Current() {
+  return std::atomic_load(&SharedTopology());
+}
+
+std::shared_ptr<const CpuTopology> CpuTopology::Refresh() {
+  auto topology = std::make_shared<const CpuTopology>(
+      Detect(kSysCpuDirectory, kSysNodeDirectory));
+  std::atomic_store(&SharedTopology(), topology);
+  return topology;
+}
+
+std::vector<unsigned int> CpuTopology::ParseCpuList(std::string_view list) {
+  std::vector<unsigned int> ids;
+  while (!list.empty()) {
+    auto comma = std::min(list.find(','), list.size());
+    auto range = list.substr(0, comma);
+    list.remove_prefix(std::min(comma + 1, list.size()));
+    unsigned int first{0};
+    auto end = range.data() + range.size();
+    auto [ptr, ec] = std::from_chars(range.data(), end, first);
+    if (ec != std::errc()) {
+      continue;
+    }
+    auto last{first};
+    if (ptr != end && *ptr == '-') {
+      std::from_chars(ptr + 1, end, last);
+    }
+    for (auto id = first; id <= last; ++id) {
+      ids.push_back(id);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+CpuTopology CpuTopology::Detect(const std::filesystem::path &cpu_root,
+                                const std::filesystem::path &node_root) {
+  CpuTopology topology;
+  auto online = ParseCpuList(ReadAttribute(cpu_root / "online"));
+  if (online.empty()) {
+    auto count = sysconf(_SC_NPROCESSORS_ONLN);
+    for (long id = 0; id < std::max(count, 1L); ++id) {
+      online.push_back(id);
+    }
+  }
+  std::set<std::pair<int, int>> cores;
+  std::set<int> packages;
+  for (auto id : online) {
+    LogicalCpu cpu;
+    cpu.id = id;
+    auto base = cpu_root / ("cpu" + std::to_string(id)) / "topology";
+    cpu.package = ReadNumber(base / "physical_package_id", 0);
+    // without core_id each logical cpu is a core on its own.
+    cpu.core = ReadNumber(base / "core_id", id);
+    cores.emplace(cpu.package, cpu.core);
+    packages.insert(cpu.package);
+    topology.cpus_.push_back(cpu);
+  }
+  std::set<int> nodes;
+  for (auto node : ParseCpuList(ReadAttribute(node_root / "online"))) {
+    auto node_cpus = ParseCpuList(ReadAttribute(
+        node_root / ("node" + std::to_string(node)) / "cpulist"));
+    for (auto &cpu : topology.cpus_) {
+      if (std::binary_search(node_cpus.begin(), node_cpus.end(), cpu.id)) {
+        cpu.node = node;
+        nodes.insert(node);
+      }
+    }
+  }
+  topology.cores_ = std::max<std::size_t>(cores.size(), 1);
+  topology.sockets_ = std::max<std::size_t>(packages.size(), 1);
+  topology.nodes_ = std::max<std::size_t>(nodes.size(), 1);
+  return topology;
+}
+
+unsigned int CpuTopology::OnlineCpus() const noexcept {
+  return std::max<std::size_t>(cpus_.size(), 1);
+}
+unsigned int CpuTopology::Cores() const noexcept { return cores_; }
+unsigned int CpuTopology::Sockets() const noexcept { return sockets_; }
+unsigned int CpuTopology::NumaNodes() const noexcept { return nodes_; }
+unsigned int CpuTopology::ThreadsPerCore() const noexcept {
+  return std::max(OnlineCpus() / cores_, 1u);
+}
+const std::vector<CpuTopology::LogicalCpu> &
+CpuTopology::Cpus() const noexcept {
+  return cpus_;
+}
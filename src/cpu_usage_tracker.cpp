@@ -0,0 +1,77 @@
+#include "cpu_usage_tracker.h"
+
+#include <algorithm>
+
+void CpuUsageTracker::BeginTick(unsigned long long total_jiffies,
+                                unsigned int num_cpus) {
+  // the first tick has no previous total: no period to compare.
+  if (generation_ > 0 && total_jiffies >= last_total_) {
+    period_ = static_cast<double>(total_jiffies - last_total_) /
+              std::max(num_cpus, 1u);
+  }
+  last_total_ = total_jiffies;
+  num_cpus_ = std::max(num_cpus, 1u);
+  ++generation_;
+}
+
+std::optional<float> CpuUsageTracker::Usage(int pid,
+                                            unsigned long long start_time,
+                                            unsigned long long ticks) {
+  auto [entry, inserted] = samples_.try_emplace(Key{pid, start_time});
+  auto &sample = entry->second;
+  if (generation_ == 1) {
+    // first refresh: we've nothing to compare with.
+    sample.ticks = ticks;
+    sample.total = last_total_;
+    sample.generation = generation_;
+    return std::nullopt;
+  }
+  if (period_ <= 0.0) {
+    // /proc/stat has not changed, i.e. Processes called twice in a refresh.
+    sample.ticks = ticks;
+    sample.generation = generation_;
+    return sample.usage;
+  }
+  // a process that we've not seen before started during the last period,
+  // so all its cpu time belongs to this period. A process kept without
+  // samples for a while is compared with its last sample.
+  auto previous = inserted ? 0 : sample.ticks;
+  auto period = period_;
+  if (!inserted && sample.total < last_total_) {
+    period = static_cast<double>(last_total_ - sample.total) / num_cpus_;
+  }
+  auto delta = ticks >= previous ? ticks - previous : 0;
+  sample.ticks = ticks;
+  sample.total = last_total_;
+  sample.usage = static_cast<float>(delta / period);
+  sample.generation = generation_;
+  return sample.usage;
+}
+
+float CpuUsageTracker::Average(unsigned long long ticks) const noexcept {
+  // jiffies of a single cpu since boot, like htop computes the period.
+  auto uptime = static_cast<double>(last_total_) / num_cpus_;
+  return uptime > 0.0 ? static_cast<float>(ticks / uptime) : 0.0f;
+}
+
+std::optional<float> CpuUsageTracker::Keep(int pid,
+                                           unsigned long long start_time) {
+  auto entry = samples_.find(Key{pid, start_time});
+  if (entry == samples_.end()) {
+    return std::nullopt;
+  }
+  entry->second.generation = generation_;
+  return entry->second.usage;
+}
+
+void CpuUsageTracker::EndTick() {
+  for (auto entry = samples_.begin(); entry != samples_.end();) {
+    if (entry->second.generation != generation_) {
+      entry = samples_.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+}
+
+std::size_t CpuUsageTracker::Size() const noexcept { return samples_.size(); }
@@ -1,6 +1,8 @@
 #include "format.h"
 
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
 #include <string>
 
 using std::string;
@@ -9,17 +11,15 @@ using std::string;
  * @brief Format value to double cipher. It is useful for date format.
  *
  * @param value  Value to be formatted.
- * @return std::string Value of rwo ciphers
+ * @param out    where the ciphers are written.
+ * @param last   end of the buffer.
+ * @return char* end of the ciphers.
  */
-static std::string formatValue(long value) {
-  std::string name;
+static char *formatValue(long value, char *out, char *last) {
   if (value < 10) {
-    name = "0" + std::to_string(value);
-
-  } else {
-    name = std::to_string(value);
+    *out++ = '0';
   }
-  return name;
+  return std::to_chars(out, last, value).ptr;
 }
 /**
  * @brief ElapsedTime is an helper function that transform
@@ -32,17 +32,64 @@ string Format::ElapsedTime(long int value) {
   if (value < 0) {
     throw std::invalid_argument("time cannot be negative");
   }
+  Field field;
+  return string(ElapsedTime(value, field));
+}
+/**
+ * @brief ElapsedTime writes uptime seconds as HH:MM:SS in a field, a
+ * negative time is written as 00:00:00.
+ *
+ * @param value  time in seconds.
+ * @param field  buffer of the text.
+ * @return std::string_view formatted time, in field.
+ */
+std::string_view Format::ElapsedTime(long int value, Field &field) noexcept {
+  value = std::max(value, 0L);
   auto hour = value / 3600;
   auto rest = value % 3600;
   auto minutes = rest / 60;
   auto seconds = rest % 60;
-  // it's very verbose but we don't have std::format C++20 here.
-  // i could use C's printf but i preferred to be stick to streams.
-  std::ostringstream os;
-  os << formatValue(hour);
-  os << ":";
-  os << formatValue(minutes);
-  os << ":";
-  os << formatValue(seconds);
-  return os.str();
-}
\ No newline at end of file
+  auto last = field.data() + field.size();
+  auto out = formatValue(hour, field.data(), last);
+  *out++ = ':';
+  out = formatValue(minutes, out, last);
+  *out++ = ':';
+  out = formatValue(seconds, out, last);
+  return std::string_view(field.data(), out - field.data());
+}
+/**
+ * @brief Megabytes formats a memory size in MB with one decimal, i.e. 12.3
+ * The decimal is truncated, not rounded.
+ *
+ * @param bytes  memory size in bytes.
+ * @return string the size in MB.
+ */
+string Format::Megabytes(unsigned long long bytes) {
+  Field field;
+  return string(Megabytes(bytes, field));
+}
+std::string_view Format::Megabytes(unsigned long long bytes,
+                                   Field &field) noexcept {
+  auto tenths = bytes * 10 / (1024 * 1024);
+  auto last = field.data() + field.size();
+  auto out = std::to_chars(field.data(), last, tenths / 10).ptr;
+  *out++ = '.';
+  out = std::to_chars(out, last, tenths % 10).ptr;
+  return std::string_view(field.data(), out - field.data());
+}
+/**
+ * @brief Percent formats a ratio as a percentage with one decimal, i.e.
+ * 0.123 is 12.3; the decimal is truncated.
+ *
+ * @param ratio  value in [0, 1], negative values are written as 0.0
+ * @param field  buffer of the text.
+ * @return std::string_view the percentage, in field.
+ */
+std::string_view Format::Percent(float ratio, Field &field) noexcept {
+  auto tenths = static_cast<long>(std::max(ratio, 0.0f) * 1000);
+  auto last = field.data() + field.size();
+  auto out = std::to_chars(field.data(), last, tenths / 10).ptr;
+  *out++ = '.';
+  out = std::to_chars(out, last, tenths % 10).ptr;
+  return std::string_view(field.data(), out - field.data());
+}
@@ -7,17 +7,16 @@
 #include <string>
 #include <vector>
 
+#include "procfs.h"
+#include "system_stat.h"
 #include "util.h"
 
-using std::stof;
 using std::string;
-using std::to_string;
 using std::vector;
-using util::ltrim;
-using util::readlines;
-using util::rtrim;
-using util::scan_pid;
-using util::splitInTwo;
+using util::parse;
+using util::parse_prefix;
+using util::split_view;
+using util::Tokenizer;
 
 /**
  * @brief Retrieve the operating system, i.e the Linux flavor
@@ -26,24 +25,20 @@ using util::splitInTwo;
  */
 string LinuxParser::OperatingSystem() {
   string line;
-  string key;
-  string value;
   std::ifstream filestream(kOSPath);
   if (filestream.is_open()) {
     while (std::getline(filestream, line)) {
-      std::replace(line.begin(), line.end(), ' ', '_');
-      std::replace(line.begin(), line.end(), '=', ' ');
-      std::replace(line.begin(), line.end(), '"', ' ');
-      std::istringstream linestream(line);
-      while (linestream >> key >> value) {
-        if (key == "PRETTY_NAME") {
-          std::replace(value.begin(), value.end(), '_', ' ');
-          return value;
+      auto [key, value] = split_view(line, "=");
+      if (key == "PRETTY_NAME") {
+        // the value can be quoted.
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+          value = value.substr(1, value.size() - 2);
         }
+        return string(value);
       }
     }
   }
-  return value;
+  return "";
 }
 /**
  * @brief Return the current kernel
@@ -51,28 +46,20 @@ string LinuxParser::OperatingSystem() {
  * @return string  Kernel version.
  */
 string LinuxParser::Kernel() {
-  string os, version, kernel;
-  string line;
-  std::ifstream stream(kProcDirectory + kVersionFilename);
-  if (stream.is_open()) {
-    std::getline(stream, line);
-    std::istringstream linestream(line);
-    linestream >> os >> version >> kernel;
+  auto content = ProcFs::Read("version");
+  if (content != std::nullopt) {
+    // Linux version <kernel> ...
+    return string(Tokenizer(*content, " ").at(2));
   }
-  return kernel;
+  return "";
 }
 
 /**
  * @brief List current processes PID
  *
- * @return vector<int> a list of current pids.
+ * @return vector<int> a sorted list of current pids.
  */
-vector<int> LinuxParser::Pids() {
-  vector<int> pids;
-  scan_pid(kProcDirectory,
-           [&pids](std::string pidname) { pids.push_back(stoi(pidname)); });
-  return pids;
-}
+vector<int> LinuxParser::Pids() { return ProcFs::Pids(); }
 
 /**
  * @brief Read the global memory utilization. The formula is simple total -
@@ -81,33 +68,26 @@ vector<int> LinuxParser::Pids() {
  * @return float the global memory utilization in megabytes
  */
 float LinuxParser::MemoryUtilization() {
-  std::filesystem::path path{LinuxParser::kProcDirectory};
-  path += LinuxParser::kMeminfoFilename;
-  std::ifstream data{path};
-  if (data.is_open()) {
-    std::string row;
-    short row_number = 0;
-    float mem_total{0};
-    float mem_avail{0};
+  auto content = ProcFs::Read("meminfo");
+  if (content != std::nullopt) {
+    std::optional<float> mem_total;
+    std::optional<float> mem_avail;
 
-    while (std::getline(data, row)) {
-      util::replace(row, "kB", "");
-      if (row_number == 0) {
-        auto [key, value] = splitInTwo(row, ":");
-        ltrim(value);
-        rtrim(value);
-        mem_total = stof(value);
-
-      } else if (row_number == 1) {
-        auto [key, value] = splitInTwo(row, ":");
-        ltrim(value);
-        rtrim(value);
-        mem_avail = stof(value);
+    for (auto row : Tokenizer(*content, "\n")) {
+      // i.e. MemTotal:       16316412 kB
+      auto [key, value] = split_view(row, ":");
+      if (key == "MemTotal") {
+        mem_total = parse_prefix<float>(value);
+      } else if (key == "MemAvailable") {
+        mem_avail = parse_prefix<float>(value);
+      }
+      if (mem_total && mem_avail) {
         break;
       }
-      row_number++;
     }
-    return ((mem_total - mem_avail) / mem_total);
+    if (mem_total && mem_avail && *mem_total > 0) {
+      return ((*mem_total - *mem_avail) / *mem_total);
+    }
   }
   return 0.0;
 }
@@ -118,15 +98,11 @@ float LinuxParser::MemoryUtilization() {
  * @return long  the rime in seconds since last reboot.
  */
 long LinuxParser::UpTime() {
-  std::filesystem::path path{LinuxParser::kProcDirectory};
-  path += LinuxParser::kUptimeFilename;
-  std::ifstream data{path};
-  if (data.is_open()) {
-    std::string current{""};
-    std::getline(data, current);
-    auto [uptime, idle] = splitInTwo(current, " ");
+  auto content = ProcFs::Read("uptime");
+  if (content != std::nullopt) {
+    auto uptime = parse_prefix<double>(*content);
     // get promoted to long.
-    return std::round(stof(uptime));
+    return uptime ? std::lround(*uptime) : 0;
   }
   return 0;
 }
@@ -138,15 +114,7 @@ long LinuxParser::UpTime() {
  *         0 in case of error.
  */
 int LinuxParser::TotalProcesses() {
-  int proc_number{0};
-  // does an equivalent of python, os.listdir and it applies
-  // the lambda to each element
-  // it's like std::transform but listing a filesystem
-  // scan_pid is used twice: here and when we build the processes.
-
-  scan_pid(LinuxParser::kProcDirectory,
-           [&proc_number](const std::string &) { proc_number++; });
-  return proc_number;
+  return static_cast<int>(ProcFs::Pids().size());
 }
 /**
  * @brief Return the running processes.
@@ -155,18 +123,9 @@ int LinuxParser::TotalProcesses() {
  * reports 0.
  */
 int LinuxParser::RunningProcesses() {
-  std::filesystem::path path{LinuxParser::kProcDirectory};
-  path += LinuxParser::kStatFilename;
-  std::ifstream data{path};
-  if (data.is_open()) {
-    std::string row;
-    while (std::getline(data, row)) {
-      if (row.find("procs_running") != std::string::npos) {
-        // we don't use key but just value in this structured binding
-        auto [key, value] = util::splitInTwo(row, " ");
-        return util::to_integral(value);
-      }
-    }
+  auto snapshot = ReadSystemStat();
+  if (snapshot != std::nullopt) {
+    return snapshot->procs_running;
   }
   return 0;
 }
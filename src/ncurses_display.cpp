@@ -2,60 +2,97 @@
 
 #include <curses.h>
 
+#include "collector.h"
 #include "format.h"
 #include "system.h"
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <iterator>
 #include <ncurses.h>
 #include <string>
-#include <thread>
+#include <utility>
 #include <vector>
 
 using std::string;
-using std::to_string;
 
 // 50 bars uniformly displayed from 0 - 100 %
 // 2% is one bar(|)
 std::string NCursesDisplay::ProgressBar(float percent) {
-  std::string result{"0%"};
+  Format::Field field;
+  return std::string(ProgressBar(percent, field));
+}
+
+std::string_view NCursesDisplay::ProgressBar(float percent,
+                                             Format::Field &field) noexcept {
+  auto out = field.data();
+  *out++ = '0';
+  *out++ = '%';
   int size{50};
   float bars{percent * size};
 
   for (int i{0}; i < size; ++i) {
-    result += i <= bars ? '|' : ' ';
+    *out++ = i <= bars ? '|' : ' ';
+  }
+  *out++ = ' ';
+  // four characters: " 9.4", "45.6" or " 100".
+  if (percent >= 1.0f) {
+    out = std::copy_n(" 100", 4, out);
+  } else {
+    Format::Field value;
+    auto text = Format::Percent(percent, value);
+    if (text.size() < 4) {
+      *out++ = ' ';
+    }
+    out = std::copy(text.begin(), text.end(), out);
   }
+  out = std::copy_n("/100%", 5, out);
+  return std::string_view(field.data(), out - field.data());
+}
+
+namespace {
+// color pairs initialized once by Display.
+constexpr short BAR_COLOR{1};
+constexpr short HEADER_COLOR{2};
+constexpr short SORT_COLOR{3};
 
-  string display{to_string(percent * 100).substr(0, 4)};
-  if (percent < 0.1 || percent == 1.0)
-    display = " " + to_string(percent * 100).substr(0, 3);
-  return result + " " + display + "/100%";
+/**
+ * @brief Write a number in the buffer without building a string.
+ */
+template <typename T>
+void PutNumber(ScreenBuffer &buffer, int row, int column, T value,
+               int width = -1) {
+  char text[24];
+  auto end = std::to_chars(std::begin(text), std::end(text), value).ptr;
+  buffer.Put(row, column, std::string_view(text, end - text), width);
 }
+} // namespace
 
-void NCursesDisplay::DisplaySystem(System &system, WINDOW *window) {
+void NCursesDisplay::DisplaySystem(const Snapshot &system,
+                                   ScreenBuffer &buffer) {
   int row{0};
-  mvwprintw(window, ++row, 2, ("OS: " + system.OperatingSystem()).c_str());
-  mvwprintw(window, ++row, 2, ("Kernel: " + system.Kernel()).c_str());
-  mvwprintw(window, ++row, 2, "CPU: ");
-  wattron(window, COLOR_PAIR(1));
-  mvwprintw(window, row, 10, "");
-  wprintw(window, ProgressBar(system.Cpu().Utilization()).c_str());
-  wattroff(window, COLOR_PAIR(1));
-  mvwprintw(window, ++row, 2, "Memory: ");
-  wattron(window, COLOR_PAIR(1));
-  mvwprintw(window, row, 10, "");
-  wprintw(window, ProgressBar(system.MemoryUtilization()).c_str());
-  wattroff(window, COLOR_PAIR(1));
-  mvwprintw(window, ++row, 2,
-            ("Total Processes: " + to_string(system.TotalProcesses())).c_str());
-  mvwprintw(
-      window, ++row, 2,
-      ("Running Processes: " + to_string(system.RunningProcesses())).c_str());
-  mvwprintw(window, ++row, 2,
-            ("Up Time: " + Format::ElapsedTime(system.UpTime())).c_str());
-  wrefresh(window);
+  buffer.Put(++row, 2, "OS: ");
+  buffer.Put(row, 6, system.operating_system);
+  buffer.Put(++row, 2, "Kernel: ");
+  buffer.Put(row, 10, system.kernel);
+  buffer.Put(++row, 2, "CPU: ");
+  // the fields are formatted in place, a frame doesn't allocate.
+  Format::Field field;
+  buffer.Put(row, 10, ProgressBar(system.cpu_utilization, field), -1,
+             BAR_COLOR);
+  buffer.Put(++row, 2, "Memory: ");
+  buffer.Put(row, 10, ProgressBar(system.memory_utilization, field), -1,
+             BAR_COLOR);
+  buffer.Put(++row, 2, "Total Processes: ");
+  PutNumber(buffer, row, 19, system.total_processes);
+  buffer.Put(++row, 2, "Running Processes: ");
+  PutNumber(buffer, row, 21, system.running_processes);
+  buffer.Put(++row, 2, "Up Time: ");
+  buffer.Put(row, 11, Format::ElapsedTime(system.uptime, field));
 }
 
-void NCursesDisplay::DisplayProcesses(std::vector<Process> &processes,
-                                      WINDOW *window, int n) {
+void NCursesDisplay::DisplayProcesses(const ProcessView &view,
+                                      ScreenBuffer &buffer, bool searching) {
   int row{0};
   int const pid_column{2};
   int const user_column{9};
@@ -63,53 +100,294 @@ void NCursesDisplay::DisplayProcesses(std::vector<Process> &processes,
   int const ram_column{26};
   int const time_column{35};
   int const command_column{46};
-  wattron(window, COLOR_PAIR(2));
-  mvwprintw(window, ++row, pid_column, "PID");
-  mvwprintw(window, row, user_column, "USER");
-  mvwprintw(window, row, cpu_column, "CPU[%%]");
-  mvwprintw(window, row, ram_column, "RAM[MB]");
-  mvwprintw(window, row, time_column, "TIME+");
-  mvwprintw(window, row, command_column, "COMMAND");
-  wattroff(window, COLOR_PAIR(2));
-  // getmaxyx(stdscr,max_rows,max_cols);
-  //  max_rows = max_rows > n ? max_rows : n;
-  int const num_processes = int(processes.size()) > n ? n : processes.size();
-  for (int i = 0; i < num_processes; ++i) {
-    mvwprintw(window, ++row, pid_column, to_string(processes[i].Pid()).c_str());
-    auto user = processes[i].User() + " ";
-    mvwprintw(window, row, user_column, user.c_str());
-    float cpu = processes[i].CpuUtilization() * 100;
-    mvwprintw(window, row, cpu_column, to_string(cpu).substr(0, 4).c_str());
-    mvwprintw(window, row, ram_column, processes[i].Ram().c_str());
-    mvwprintw(window, row, time_column,
-              Format::ElapsedTime(processes[i].UpTime()).c_str());
-    mvwprintw(window, row, command_column,
-              processes[i].Command().substr(0, window->_maxx - 46).c_str());
+  // the column of the order is highlighted.
+  auto header = [&buffer, &view, &row](int column, std::string_view title,
+                                       SortKey key) {
+    buffer.Put(row, column, title, -1,
+               view.Key() == key ? SORT_COLOR : HEADER_COLOR);
+  };
+  ++row;
+  header(pid_column, "PID", SortKey::kPid);
+  header(user_column, "USER", SortKey::kUser);
+  header(cpu_column, "CPU[%]", SortKey::kCpu);
+  header(ram_column, "RAM[MB]", SortKey::kMemory);
+  header(time_column, "TIME+", SortKey::kTime);
+  header(command_column, "COMMAND", SortKey::kCommand);
+  // the strings are views in the table, copied in the buffer and clipped
+  // to the width of the column; the border is left alone.
+  int const last_column = buffer.Columns() - buffer.Border();
+  const auto &processes = view.Table();
+  // the fields are formatted in place, a frame doesn't allocate.
+  Format::Field field;
+  for (std::size_t line = 0; line < view.Visible(); ++line) {
+    auto i = view.Row(line);
+    PutNumber(buffer, ++row, pid_column, processes.Pid(i),
+              user_column - pid_column - 1);
+    buffer.Put(row, user_column, processes.User(i),
+               cpu_column - user_column - 1);
+    buffer.Put(row, cpu_column,
+               Format::Percent(processes.CpuUtilization(i), field),
+               ram_column - cpu_column - 1);
+    // formatted only for the rows on the screen; kernel threads have no
+    // memory of their own.
+    auto vsz = processes.Vsz(i);
+    if (vsz > 0) {
+      buffer.Put(row, ram_column, Format::Megabytes(vsz, field),
+                 time_column - ram_column - 1);
+    }
+    buffer.Put(row, time_column,
+               Format::ElapsedTime(processes.UpTime(i), field),
+               command_column - time_column - 1);
+    // threads are indented under their process.
+    int indent = processes.IsThread(i) ? 2 : 0;
+    buffer.Put(row, command_column + indent, processes.Command(i),
+               last_column - command_column - indent);
+  }
+  // status line, under the rows.
+  row = static_cast<int>(view.Height()) + 2;
+  int column{pid_column};
+  auto status = [&](std::string_view text, short color = 0) {
+    auto width = std::min<int>(text.size(), std::max(last_column - column, 0));
+    buffer.Put(row, column, text, width, color);
+    column += width;
+  };
+  auto number = [&](std::size_t value) {
+    char text[24];
+    auto end = std::to_chars(std::begin(text), std::end(text), value).ptr;
+    status(std::string_view(text, end - text));
+  };
+  if (view.Visible() > 0) {
+    status("Rows ");
+    number(view.Offset() + 1);
+    status("-");
+    number(view.Offset() + view.Visible());
+    status(" of ");
+    number(view.Size());
+    status("  ");
+  }
+  if (searching || !view.Query().empty()) {
+    status("Search: ");
+    status(view.Query(), SORT_COLOR);
+    status(searching ? "_  " : "  ");
+  }
+  status(searching ? "enter done, esc clear"
+                   : "q quit, / search, p u c m t n sort, H threads, "
+                     "arrows scroll");
+}
+
+NCursesDisplay::Action NCursesDisplay::HandleKey(int key, ProcessView &view,
+                                                 std::string &search,
+                                                 bool &searching) {
+  if (searching) {
+    // the rows are filtered while typing.
+    switch (key) {
+    case '\n':
+    case KEY_ENTER:
+      searching = false;
+      return Action::kRedraw;
+    case 27: // escape
+      searching = false;
+      search.clear();
+      break;
+    case KEY_BACKSPACE:
+    case 127:
+    case '\b':
+      if (!search.empty()) {
+        search.pop_back();
+      }
+      break;
+    default:
+      if (key < ' ' || key > '~') {
+        return Action::kNone;
+      }
+      search.push_back(static_cast<char>(key));
+      break;
+    }
+    view.Search(search);
+    return Action::kRedraw;
+  }
+  auto page = static_cast<long>(view.Height());
+  switch (key) {
+  case 'q':
+  case 'Q':
+    return Action::kQuit;
+  case '/':
+    searching = true;
+    return Action::kRedraw;
+  case 'H':
+    // switched by the collector, shown with the next snapshot.
+    return Action::kToggleThreads;
+  case 27: // escape
+    search.clear();
+    view.Search(search);
+    break;
+  case 'p':
+    view.SortBy(SortKey::kPid);
+    break;
+  case 'u':
+    view.SortBy(SortKey::kUser);
+    break;
+  case 'c':
+    view.SortBy(SortKey::kCpu);
+    break;
+  case 'm':
+    view.SortBy(SortKey::kMemory);
+    break;
+  case 't':
+    view.SortBy(SortKey::kTime);
+    break;
+  case 'n':
+    view.SortBy(SortKey::kCommand);
+    break;
+  case KEY_UP:
+  case 'k':
+    view.ScrollBy(-1);
+    break;
+  case KEY_DOWN:
+  case 'j':
+    view.ScrollBy(1);
+    break;
+  case KEY_PPAGE:
+    view.ScrollBy(-page);
+    break;
+  case KEY_NPAGE:
+  case ' ':
+    view.ScrollBy(page);
+    break;
+  case KEY_HOME:
+    view.ScrollTo(0);
+    break;
+  case KEY_END:
+    view.ScrollTo(view.Size());
+    break;
+  default:
+    return Action::kNone;
   }
+  return Action::kRedraw;
 }
 
-void NCursesDisplay::Display(System &system, const int &n) {
+void NCursesDisplay::Layout(Screen &screen, ProcessView &view) {
+  int rows{0};
+  int columns{0};
+  getmaxyx(stdscr, rows, columns);
+  // whatever the windows don't cover is blank.
+  werase(stdscr);
+  screen.fits = rows >= SYSTEM_ROWS + PROCESS_FRAME_ROWS + 1 &&
+                columns >= MIN_COLUMNS;
+  if (!screen.fits) {
+    mvwaddnstr(stdscr, 0, 0, "The terminal is too small", columns);
+    wnoutrefresh(stdscr);
+    doupdate();
+    return;
+  }
+  wnoutrefresh(stdscr);
+  // resized before being moved, so they always fit in the terminal.
+  wresize(screen.system_window, SYSTEM_ROWS, columns - 1);
+  mvwin(screen.system_window, 0, 0);
+  wresize(screen.process_window, rows - SYSTEM_ROWS, columns - 1);
+  mvwin(screen.process_window, SYSTEM_ROWS, 0);
+  // every cell inside the borders is drawn again by the next frame.
+  screen.system_buffer.Resize(getmaxy(screen.system_window),
+                              getmaxx(screen.system_window));
+  screen.process_buffer.Resize(getmaxy(screen.process_window),
+                               getmaxx(screen.process_window));
+  for (auto window : {screen.system_window, screen.process_window}) {
+    werase(window);
+    // the buffers never write the borders.
+    box(window, 0, 0);
+  }
+  // only the rows that fit are sorted and formatted.
+  view.SetHeight(rows - SYSTEM_ROWS - PROCESS_FRAME_ROWS);
+}
+
+void NCursesDisplay::Draw(ScreenBuffer &buffer, WINDOW *window) {
+  buffer.Flush([window](int row, int column, const char *text, int length,
+                        short color) {
+    if (color != 0) {
+      wattron(window, COLOR_PAIR(color));
+    }
+    mvwaddnstr(window, row, column, text, length);
+    if (color != 0) {
+      wattroff(window, COLOR_PAIR(color));
+    }
+  });
+  wnoutrefresh(window);
+}
+
+void NCursesDisplay::Display(System &system) {
   initscr();     // start ncurses
   noecho();      // do not print input values
   cbreak();      // terminate ncurses on ctrl + c
+  curs_set(0);   // no cursor over the rows
   start_color(); // enable color
+  // escape clears the search, without the default wait of a second.
+  set_escdelay(25);
+  init_pair(BAR_COLOR, COLOR_BLUE, COLOR_BLACK);
+  init_pair(HEADER_COLOR, COLOR_GREEN, COLOR_BLACK);
+  init_pair(SORT_COLOR, COLOR_BLACK, COLOR_GREEN);
 
-  int x_max{getmaxx(stdscr)};
-  WINDOW *system_window = newwin(9, x_max - 1, 0, 0);
-  WINDOW *process_window =
-      newwin(3 + n, x_max - 1, system_window->_maxy + 1, 0);
-
+  // sized to the terminal by Layout.
+  Screen screen;
+  screen.system_window = newwin(1, 1, 0, 0);
+  screen.process_window = newwin(1, 1, 0, 0);
+  // the input is read on the frame timer: a key is handled as soon as it's
+  // pressed, without waiting for the collector.
+  keypad(screen.process_window, TRUE);
+  wtimeout(screen.process_window, FRAME_INTERVAL.count());
+  // the refreshes run on the collector thread, whatever they cost the
+  // screen is drawn from the latest snapshot. The view orders its own copy,
+  // the heaviest processes first.
+  ProcessView view{0};
+  Layout(screen, view);
+  std::string search;
+  bool searching{false};
+  Collector collector{system};
+  collector.Start();
+  // drawn by the last frame.
+  std::shared_ptr<const Snapshot> snapshot;
+  bool dirty{false};
   while (1) {
-    init_pair(1, COLOR_BLUE, COLOR_BLACK);
-    init_pair(2, COLOR_GREEN, COLOR_BLACK);
-    box(system_window, 0, 0);
-    box(process_window, 0, 0);
-    DisplaySystem(system, system_window);
-    DisplayProcesses(system.Processes(), process_window, n);
-    wrefresh(system_window);
-    wrefresh(process_window);
-    refresh();
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    auto latest = collector.Latest();
+    if (latest != nullptr && latest != snapshot) {
+      view.Update(latest->processes);
+      // the view has its own copy, the old snapshot can be filled again.
+      collector.Release(std::exchange(snapshot, std::move(latest)));
+      dirty = true;
+    }
+    if (snapshot != nullptr && dirty && screen.fits) {
+      auto start = std::chrono::steady_clock::now();
+      screen.system_buffer.Clear();
+      DisplaySystem(*snapshot, screen.system_buffer);
+      Draw(screen.system_buffer, screen.system_window);
+      screen.process_buffer.Clear();
+      DisplayProcesses(view, screen.process_buffer, searching);
+      Draw(screen.process_buffer, screen.process_window);
+      doupdate();
+      dirty = false;
+      collector.RecordRender(std::chrono::steady_clock::now() - start);
+    }
+    // waits for a key at most a frame.
+    auto key = wgetch(screen.process_window);
+    if (key == ERR) {
+      continue;
+    }
+    // ncurses catches SIGWINCH, resizes the terminal and returns this key.
+    if (key == KEY_RESIZE) {
+      Layout(screen, view);
+      dirty = true;
+      continue;
+    }
+    auto action = HandleKey(key, view, search, searching);
+    if (action == Action::kQuit) {
+      break;
+    }
+    if (action == Action::kToggleThreads) {
+      collector.SetThreadsMode(!collector.ThreadsMode());
+    }
+    dirty |= action == Action::kRedraw;
   }
+  collector.Stop();
+  delwin(screen.process_window);
+  delwin(screen.system_window);
   endwin();
 }
@@ -2,7 +2,10 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cerrno>
 #include <cmath>
 #include <sstream>
 #include <stdexcept>
@@ -10,19 +13,18 @@
 #include <vector>
 
 #include "cpu_sampler.h"
+#include "cpu_topology.h"
 #include "linux_parser.h"
 #include "processor.h"
+#include "procfs.h"
+#include "user_directory.h"
 #include "util.h"
 
 using std::string;
 using std::to_string;
 using std::vector;
 using util::is_number;
-using util::ltrim;
-using util::rtrim;
-using util::scan_pid;
-using util::split;
-using util::splitInTwo;
+using util::parse;
 
 /**
  * @brief Build a process information using the directory.
@@ -31,238 +33,312 @@ using util::splitInTwo;
  * @return Process
  */
 Process ProcessBuilder::Build(const std::filesystem::path &directory) {
-  Process p;
+  auto system_stat = LinuxParser::ReadSystemStat().value_or(
+      LinuxParser::SystemStatSnapshot{});
+  return Build(directory, system_stat);
+}
+/**
+ * @brief Build a process information using the directory and the
+ * /proc/stat snapshot of the current refresh.
+ *
+ * @param directory
+ * @param system_stat
+ * @return Process
+ */
+Process
+ProcessBuilder::Build(const std::filesystem::path &directory,
+                      const LinuxParser::SystemStatSnapshot &system_stat) {
   std::string pid(directory.filename());
-  std::filesystem::path procDir(LinuxParser::kProcDirectory);
-  procDir += pid;
-
   if (!is_number(pid)) {
     throw std::invalid_argument("uid shall be a number");
   }
-
-  p.pid_ = std::stoi(pid);
-  p.user_ = FindUser(procDir);
-  p.uptime_ = FindUptime(procDir);
-  p.cpu_usage_ = FindCpuUsage(procDir);
-  p.command_ = FindCommand(procDir);
-  p.ram_ = FindMemoryUsage(procDir);
-  return p;
+  auto process = TryBuild(parse<int>(pid).value_or(0));
+  if (!process) {
+    throw std::runtime_error("cannot read the process " + pid + ": " +
+                             ToString(process.error()));
+  }
+  // a tracker of its own, its first tick gives the average since boot.
+  CpuUsageTracker tracker;
+  tracker.BeginTick(system_stat.cpu.Total(),
+                    CpuTopology::Current()->OnlineCpus());
+  UpdateCpuUsage(*process, tracker);
+  return std::move(process).value();
 }
+namespace {
+// the first file missing means that the process was not there, after that
+// it has exited while we were reading it.
+ProcessError ReadError(bool first_read) {
+  if (first_read && errno == ENOENT) {
+    return ProcessError::kNotFound;
+  }
+  return ProcessError::kExited;
+}
+} // namespace
 /**
- * @brief Find the uptime looking in /proc/pid
+ * @brief Build a process without throwing when it's gone or unreadable.
  *
- * @param base subdirectory /proc/PID
- * @return long the value in uptime.
+ * @param pid
+ * @param strings
+ * @return util::Expected<Process, ProcessError>
  */
-long ProcessBuilder::FindUptime(const std::filesystem::path &base) {
-  std::filesystem::path userstat{base};
-  userstat += LinuxParser::kStatFilename;
-  std::ifstream userdata{userstat};
-  if (userdata.is_open()) {
-    auto contents = util::readlines(userdata);
-    auto fields = util::split(contents, ' ');
-    if (fields.size() < 22) {
-      return 0;
-    }
-    /*
-     * In the spec we've the uptime(field 21) but both top and htop use the
-     * utime + stime for TIME+, we've decided to be close to htop and top. In
-     * we'd to use field 21, no need to multiply * 60. we've chosed to get stick
-     * to the standard and have a comparison during testing.
-     * I checked the code in htop. If we launch htop or top we'll have the same
-     * values.
-     */
-    auto update = 60 * (std::stol(fields[13]) + std::stol(fields[14])) /
-                  sysconf(_SC_CLK_TCK);
-    return update;
+util::Expected<Process, ProcessError>
+ProcessBuilder::TryBuild(int pid, StringPool::Cache &strings) {
+  if (pid <= 0) {
+    return util::unexpected(ProcessError::kInvalidPid);
+  }
+  Process p;
+  p.pid_ = pid;
+  p.tgid_ = pid;
+  // /proc/PID/stat is read just once and shared by all the Find* functions.
+  auto content = LinuxParser::ProcFs::ReadPid(pid, "stat");
+  if (content == std::nullopt) {
+    return util::unexpected(ReadError(true));
+  }
+  auto stat = LinuxParser::ParseProcessStat(*content);
+  if (stat == std::nullopt) {
+    return util::unexpected(ProcessError::kParseError);
   }
-  return 0;
+  // the same for /proc/PID/status, used for the user.
+  content = LinuxParser::ProcFs::ReadPid(pid, "status");
+  if (content == std::nullopt) {
+    return util::unexpected(ReadError(false));
+  }
+  auto status = LinuxParser::ParseProcessStatus(*content);
+  if (status == std::nullopt) {
+    return util::unexpected(ProcessError::kParseError);
+  }
+  auto statm = LinuxParser::ReadProcessStatm(pid);
+  if (statm == std::nullopt) {
+    return util::unexpected(ReadError(false));
+  }
+  p.user_ = strings.Intern(FindUser(*status));
+  p.uptime_ = FindUptime(*stat);
+  p.start_time_ = stat->starttime;
+  p.cpu_ticks_ = stat->utime + stat->stime;
+  p.command_ = strings.Intern(FindCommand(pid, *stat));
+  FindMemoryUsage(p, *statm);
+  return p;
 }
-
 /**
- * @brief Find a user associated to the process
+ * @brief Build a process interning its strings in the shared pool.
  *
- * @param base   base directory in /proc/PID
- * @return std::string a string containing the username.
+ * @param pid
+ * @return util::Expected<Process, ProcessError>
  */
-std::string ProcessBuilder::FindUser(const std::filesystem::path &base) {
-  std::filesystem::path userstat{base};
-  userstat += LinuxParser::kStatusFilename;
-  std::ifstream userdata{userstat};
-  if (userdata.is_open()) {
-    std::string data;
-    std::string uid;
-    while (std::getline(userdata, data)) {
-      if (data.find("Uid") != std::string::npos) {
-        auto [first, second] = util::splitInTwo(data, ":");
-        // i use just the second part and remove blanks
-        util::replace(second, "\t", "");
-        auto values = util::split(second, '\t');
-        uid = values[0];
-        // now we've to open /etc/passwd
-        break;
-      }
-    }
-    // so we've the uid
-    std::ifstream userdb{LinuxParser::kPasswordPath};
-    // we scan until we found  a line with the id.
-    if (userdb.is_open()) {
-      while (std::getline(userdb, data)) {
-        if (data.find(uid) != std::string::npos) {
-          auto fields = util::split(data, ':');
-          if ((fields.size() > 2) &&
-              (is_number(fields[2]) && fields[2] == uid)) {
-            // ok we've done.
-            return fields[0];
-          }
-        }
-      }
-    }
+util::Expected<Process, ProcessError> ProcessBuilder::TryBuild(int pid) {
+  StringPool::Cache strings{StringPool::Shared()};
+  return TryBuild(pid, strings);
+}
+/**
+ * @brief Update the volatile values of a process built in a previous
+ * refresh: only stat and statm are read, the user and the command are kept.
+ *
+ * @param process  process to update
+ * @param strings  cache for the command line, nullptr for keeping it
+ * @return true if the process has been updated.
+ * @return false if the process has exited or its pid has been reused.
+ */
+bool ProcessBuilder::Update(Process &process, StringPool::Cache *strings) {
+  auto stat = LinuxParser::ReadProcessStat(process.pid_);
+  if (stat == std::nullopt || stat->starttime != process.start_time_) {
+    return false;
+  }
+  if (strings != nullptr) {
+    process.command_ = strings->Intern(FindCommand(process.pid_, *stat));
   }
-  return "";
+  process.uptime_ = FindUptime(*stat);
+  process.cpu_ticks_ = stat->utime + stat->stime;
+  auto statm = LinuxParser::ReadProcessStatm(process.pid_);
+  if (statm != std::nullopt) {
+    FindMemoryUsage(process, *statm);
+  }
+  return true;
 }
 /**
- * @brief Find the cpu usage for the current process.
+ * @brief Build a thread of a process.
  *
- * @param base  path in /proc for the current process
- * @return float cpu usage for the current process
+ * @param process
+ * @param tid
+ * @param strings
+ * @return util::Expected<Process, ProcessError>
  */
-float ProcessBuilder::FindCpuUsage(const std::filesystem::path &base) {
-  std::filesystem::path path{base};
-  std::filesystem::path procBase{LinuxParser::kProcDirectory};
-  std::filesystem::path globalStatPath{procBase};
-  globalStatPath += LinuxParser::kStatFilename;
-
-  auto cpus = DetectProcessor::GetSystemProcessors();
-  auto num_cpus{1};
-  if (cpus == std::nullopt) {
-    num_cpus = 1;
-  } else {
-    num_cpus = cpus.value().size();
+util::Expected<Process, ProcessError>
+ProcessBuilder::TryBuildThread(const Process &process, int tid,
+                               StringPool::Cache &strings) {
+  if (tid <= 0) {
+    return util::unexpected(ProcessError::kInvalidPid);
   }
-  // we get the total cpu usage
-  auto totalCpuUsage = GetTotalCpuUsage(num_cpus);
-  std::filesystem::path procStatPath{path};
-  procStatPath += LinuxParser::kStatFilename;
-
-  std::ifstream procStat{procStatPath};
-
-  auto contents = util::readlines(procStat);
-  if (contents.size() != 0) {
-    auto usage_data = util::split(contents, ' ');
-    float utime = stof(usage_data[13]);
-    float stime = stof(usage_data[14]);
-    auto cpu_usage = (utime + stime) / totalCpuUsage;
-    return cpu_usage;
+  // task/TID/stat, relative to the cached directory of the process.
+  char path[32]{"task/"};
+  auto end = std::to_chars(path + 5, path + sizeof(path) - 6, tid).ptr;
+  std::string_view stat_name{"/stat"};
+  std::copy(stat_name.begin(), stat_name.end(), end);
+  auto content = LinuxParser::ProcFs::ReadPid(process.pid_, path);
+  if (content == std::nullopt) {
+    return util::unexpected(ReadError(true));
   }
-  return 0.0f;
+  auto stat = LinuxParser::ParseProcessStat(*content);
+  if (stat == std::nullopt) {
+    return util::unexpected(ProcessError::kParseError);
+  }
+  Process t{process};
+  t.pid_ = tid;
+  t.thread_ = true;
+  // read right now, whether its process has been skipped or not.
+  t.sampled_ = true;
+  t.idle_refreshes_ = 0;
+  t.command_ = strings.Intern(stat->Comm());
+  t.uptime_ = FindUptime(*stat);
+  t.start_time_ = stat->starttime;
+  t.cpu_ticks_ = stat->utime + stat->stime;
+  return t;
 }
 /**
- * @brief Find memory usage for the current process
+ * @brief Keep the strings of a process in the pool.
  *
- * @param base path in /proc for the current process
- * @return std::string memory usage.
+ * @param process
+ * @param strings
  */
-std::string ProcessBuilder::FindMemoryUsage(const std::filesystem::path &base) {
-  std::filesystem::path path{base};
-  path += LinuxParser::kStatusFilename;
-  std::ifstream stream{path};
-  std::string current;
-
-  if (stream.is_open()) {
-    while (std::getline(stream, current)) {
-      if (current.find("VmSize") != std::string::npos) {
-        auto [first, second] = util::splitInTwo(current, ":");
-        util::replace(second, "kB", "");
-        util::ltrim(second);
-        util::rtrim(second);
-        auto ram = std::to_string(stof(second) / 1024.0f);
-        return ram.substr(0, ram.find(".") + 2);
-      }
+void ProcessBuilder::MarkStrings(const Process &process, StringPool &strings) {
+  strings.Mark(process.user_);
+  strings.Mark(process.command_);
+}
+/**
+ * @brief Update the cpu usage with the delta since the previous refresh.
+ *
+ * @param process  process built in the current refresh
+ * @param tracker  cpu time of the processes in the previous refresh
+ */
+void ProcessBuilder::UpdateCpuUsage(Process &process,
+                                    CpuUsageTracker &tracker) {
+  if (!process.sampled_) {
+    process.sampled_ = true;
+    // the ticks are the old ones, the next sample covers this refresh too.
+    auto kept = tracker.Keep(process.pid_, process.start_time_);
+    if (kept != std::nullopt) {
+      process.cpu_usage_ = kept.value();
+      return;
     }
+    // not tracked (new since its last sample or a reused pid): sampled now.
   }
-  return "";
+  auto usage =
+      tracker.Usage(process.pid_, process.start_time_, process.cpu_ticks_);
+  if (usage == std::nullopt) {
+    // first refresh: no period yet.
+    process.cpu_usage_ = tracker.Average(process.cpu_ticks_);
+    return;
+  }
+  process.cpu_usage_ = usage.value();
+  process.idle_refreshes_ =
+      usage.value() > 0.0f ? 0 : process.idle_refreshes_ + 1;
+}
+/**
+ * @brief Skip the process in the current refresh.
+ *
+ * @param process
+ */
+void ProcessBuilder::Skip(Process &process) { process.sampled_ = false; }
+/**
+ * @brief Find the uptime looking in /proc/pid/stat
+ *
+ * @param stat parsed /proc/PID/stat record
+ * @return long the value in uptime.
+ */
+long ProcessBuilder::FindUptime(const LinuxParser::ProcessStat &stat) {
+  /*
+   * In the spec we've the uptime(field 21) but both top and htop use the
+   * utime + stime for TIME+, we've decided to be close to htop and top. In
+   * we'd to use field 21, no need to multiply * 60. we've chosed to get stick
+   * to the standard and have a comparison during testing.
+   * I checked the code in htop. If we launch htop or top we'll have the same
+   * values.
+   */
+  auto update = 60 * static_cast<long>(stat.utime + stat.stime) /
+                sysconf(_SC_CLK_TCK);
+  return update;
 }
 
 /**
- * @brief Find the current command for the current process
+ * @brief Find a user associated to the process
  *
- * @param base  path in /proc for the current process
- * @return std::string
+ * @param status parsed /proc/PID/status
+ * @return std::string a string containing the username.
  */
-std::string ProcessBuilder::FindCommand(const std::filesystem::path &base) {
-  std::filesystem::path path;
-  std::string contents;
-  contents.resize(2048);
-  path += base;
-  path += "/cmdline";
-  std::ifstream current{path};
-  std::getline(current, contents);
-  if (contents.size() == 0) {
-    // we look at /status first line and split
-    std::filesystem::path status;
-    status += base;
-    status += "/status";
-    std::ifstream current{status};
-    std::getline(current, contents);
-    auto v = util::split(contents, ':');
-    util::ltrim(v[1]);
-    current.close();
-    return v[1];
-  } else {
-    auto exe = util::split(contents, '\00');
-    return exe[0];
-  }
-  return contents;
+std::string
+ProcessBuilder::FindUser(const LinuxParser::ProcessStatus &status) {
+  // the real uid is the first of the four ids, the directory is in memory
+  // and kept up to date by System.
+  return UserDirectory::Instance().Find(status.uid[0]);
 }
 /**
- * @brief Return the average totaltime
+ * @brief Find memory usage for the current process
  *
- * @return unsigned long long int
+ * @param process process to update
+ * @param statm parsed /proc/PID/statm
  */
-unsigned long long int ProcessBuilder::GetTotalCpuUsage(unsigned int num_cpu) {
-  std::filesystem::path path{LinuxParser::kProcDirectory};
-  path += LinuxParser::kStatFilename;
-  std::ifstream data{path};
-  std::string row;
-  if (data.is_open()) {
-    std::getline(data, row);
-    // this part is inspired by htop code in LinuxProcessList.c
-    // there is a part where for CPU computtes the period
-    // we're doing something similar here.
+void ProcessBuilder::FindMemoryUsage(Process &process,
+                                     const LinuxParser::ProcessStatm &statm) {
+  static const unsigned long long page_size = sysconf(_SC_PAGESIZE);
+  // kernel threads have no address space and no size.
+  process.vsz_ = statm.size * page_size;
+  process.rss_ = statm.resident * page_size;
+  process.shared_ = statm.shared * page_size;
+}
 
-    auto fields = util::split(row, ' ');
-    auto usertime = stoul(fields[2]);
-    auto nicetime = stoul(fields[3]);
-    auto systemtime = stoul(fields[4]);
-    auto idletime = stoul(fields[5]);
-    auto ioWait = stoul(fields[6]);
-    auto irq = stoul(fields[7]);
-    auto softIrq = stoul(fields[8]);
-    auto steal = stoul(fields[9]);
-    auto guest = stoul(fields[10]);
-    auto guestnice = stoul(fields[11]);
-    // this is based on htop calculation.
-    usertime = usertime - guest;
-    nicetime = nicetime - guestnice;
-    unsigned long long int idlealltime = idletime + ioWait;
-    unsigned long long int systemalltime = systemtime + irq + softIrq;
-    unsigned long long int virtalltime = guest + guestnice;
-    // total global time spent on average in the cpu + io.
-    unsigned long long int totaltime =
-        usertime + nicetime + systemalltime + idlealltime + steal + virtalltime;
-    return totaltime / num_cpu;
+/**
+ * @brief Find the current command for the current process
+ *
+ * @param pid   process id of the current process
+ * @param stat  parsed /proc/PID/stat record of the current process
+ * @return std::string_view
+ */
+std::string_view
+ProcessBuilder::FindCommand(int pid, const LinuxParser::ProcessStat &stat) {
+  auto contents = LinuxParser::ProcFs::ReadPid(pid, "cmdline");
+  if (!contents || contents->empty()) {
+    // no command line (i.e. kernel threads): the comm in stat is the same
+    // name that we'd find in the first line of /status.
+    return stat.Comm();
+  }
+  // arguments are divided by \0, we keep the executable.
+  return contents->substr(0, contents->find('\0'));
+}
+std::string ToString(ProcessError error) {
+  switch (error) {
+  case ProcessError::kInvalidPid:
+    return "invalid pid";
+  case ProcessError::kNotFound:
+    return "no such process";
+  case ProcessError::kExited:
+    return "process exited";
+  case ProcessError::kParseError:
+    return "malformed file";
   }
-  return 0;
+  return "unknown error";
 }
+
 int Process::Pid() const noexcept { return pid_; }
 
 float Process::CpuUtilization() const noexcept { return cpu_usage_; }
-string Process::Command() const noexcept { return command_; }
+std::string_view Process::Command() const noexcept {
+  return command_.View();
+}
+
+unsigned int Process::IdleRefreshes() const noexcept {
+  return idle_refreshes_;
+}
+
+int Process::Tgid() const noexcept { return tgid_; }
+
+bool Process::IsThread() const noexcept { return thread_; }
+
+unsigned long long Process::Vsz() const noexcept { return vsz_; }
+
+unsigned long long Process::Rss() const noexcept { return rss_; }
 
-string Process::Ram() const noexcept { return ram_; }
+unsigned long long Process::Shared() const noexcept { return shared_; }
 
-string Process::User() const noexcept { return user_; }
+std::string_view Process::User() const noexcept { return user_.View(); }
 
 long int Process::UpTime() const noexcept { return uptime_; }
 
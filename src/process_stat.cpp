@@ -0,0 +1,126 @@
+#include "process_stat.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <charconv>
+
+#include "linux_parser.h"
+#include "procfs.h"
+
+namespace LinuxParser {
+namespace {
+// we need at least up to rss (field 24) for a meaningful record.
+constexpr int MANDATORY_FIELDS{21};
+
+/**
+ * @brief FieldCursor walks the space separated fields after the comm.
+ * It never allocates: each token is a view on the original record.
+ */
+class FieldCursor final {
+public:
+  explicit FieldCursor(std::string_view data) : data_(data) {}
+
+  std::string_view Next() noexcept {
+    auto start = data_.find_first_not_of(" \n");
+    if (start == std::string_view::npos) {
+      data_ = {};
+      return {};
+    }
+    data_.remove_prefix(start);
+    auto end = std::min(data_.find_first_of(" \n"), data_.size());
+    auto token = data_.substr(0, end);
+    data_.remove_prefix(end);
+    return token;
+  }
+
+  template <typename T> bool Next(T &value) noexcept {
+    auto token = Next();
+    if (token.empty()) {
+      return false;
+    }
+    auto [ptr, ec] =
+        std::from_chars(token.data(), token.data() + token.size(), value);
+    return (ec == std::errc()) && (ptr == token.data() + token.size());
+  }
+
+private:
+  std::string_view data_;
+};
+} // namespace
+
+std::optional<ProcessStat> ParseProcessStat(std::string_view record) noexcept {
+  ProcessStat stat;
+  auto open = record.find('(');
+  auto close = record.rfind(')');
+  if (open == std::string_view::npos || close == std::string_view::npos ||
+      close < open) {
+    return std::nullopt;
+  }
+  FieldCursor head{record.substr(0, open)};
+  if (!head.Next(stat.pid)) {
+    return std::nullopt;
+  }
+  auto comm = record.substr(open + 1, close - open - 1);
+  stat.comm_length = std::min(comm.size(), ProcessStat::COMM_SIZE);
+  std::copy_n(comm.data(), stat.comm_length, stat.comm.data());
+
+  FieldCursor fields{record.substr(close + 1)};
+  auto state = fields.Next();
+  if (state.size() != 1) {
+    return std::nullopt;
+  }
+  stat.state = state[0];
+  // fields are parsed in the proc(5) order, the && chain stops at the first
+  // missing one: we count how many we got for checking the mandatory ones.
+  int parsed{0};
+  auto next = [&fields, &parsed](auto &value) {
+    if (fields.Next(value)) {
+      ++parsed;
+      return true;
+    }
+    return false;
+  };
+  next(stat.ppid) && next(stat.pgrp) && next(stat.session) &&
+      next(stat.tty_nr) && next(stat.tpgid) && next(stat.flags) &&
+      next(stat.minflt) && next(stat.cminflt) && next(stat.majflt) &&
+      next(stat.cmajflt) && next(stat.utime) && next(stat.stime) &&
+      next(stat.cutime) && next(stat.cstime) && next(stat.priority) &&
+      next(stat.nice) && next(stat.num_threads) && next(stat.itrealvalue) &&
+      next(stat.starttime) && next(stat.vsize) && next(stat.rss) &&
+      next(stat.rsslim) && next(stat.startcode) && next(stat.endcode) &&
+      next(stat.startstack) && next(stat.kstkesp) && next(stat.kstkeip) &&
+      next(stat.signal) && next(stat.blocked) && next(stat.sigignore) &&
+      next(stat.sigcatch) && next(stat.wchan) && next(stat.nswap) &&
+      next(stat.cnswap) && next(stat.exit_signal) && next(stat.processor) &&
+      next(stat.rt_priority) && next(stat.policy) &&
+      next(stat.delayacct_blkio_ticks) && next(stat.guest_time) &&
+      next(stat.cguest_time) && next(stat.start_data) &&
+      next(stat.end_data) && next(stat.start_brk) && next(stat.arg_start) &&
+      next(stat.arg_end) && next(stat.env_start) && next(stat.env_end) &&
+      next(stat.exit_code);
+  if (parsed < MANDATORY_FIELDS) {
+    return std::nullopt;
+  }
+  return stat;
+}
+
+std::optional<ProcessStat>
+ReadProcessStat(const std::filesystem::path &process_dir) {
+  std::filesystem::path path{process_dir};
+  path += kStatFilename;
+  auto content = ProcFs::Read(AT_FDCWD, path.c_str());
+  if (content == std::nullopt) {
+    return std::nullopt;
+  }
+  return ParseProcessStat(content.value());
+}
+
+std::optional<ProcessStat> ReadProcessStat(int pid) {
+  auto content = ProcFs::ReadPid(pid, "stat");
+  if (content == std::nullopt) {
+    return std::nullopt;
+  }
+  return ParseProcessStat(content.value());
+}
+} // namespace LinuxParser
@@ -0,0 +1,35 @@
+#include "process_statm.h"
+
+#include "procfs.h"
+#include "util.h"
+
+namespace LinuxParser {
+
+std::optional<ProcessStatm>
+ParseProcessStatm(std::string_view content) noexcept {
+  ProcessStatm statm;
+  util::Tokenizer fields{content, " \n"};
+  auto field = fields.begin();
+  for (auto *value : {&statm.size, &statm.resident, &statm.shared,
+                      &statm.text, &statm.lib, &statm.data, &statm.dt}) {
+    if (field == fields.end()) {
+      return std::nullopt;
+    }
+    auto parsed = util::parse<unsigned long>(*field);
+    if (parsed == std::nullopt) {
+      return std::nullopt;
+    }
+    *value = parsed.value();
+    ++field;
+  }
+  return statm;
+}
+
+std::optional<ProcessStatm> ReadProcessStatm(int pid) {
+  auto content = ProcFs::ReadPid(pid, "statm");
+  if (content == std::nullopt) {
+    return std::nullopt;
+  }
+  return ParseProcessStatm(content.value());
+}
+} // namespace LinuxParser
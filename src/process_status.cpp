@@ -0,0 +1,197 @@
+#include "process_status.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <charconv>
+
+#include "linux_parser.h"
+#include "procfs.h"
+#include "util.h"
+
+namespace LinuxParser {
+namespace {
+constexpr std::string_view BLANKS{" \t"};
+
+/**
+ * @brief Parse the first number of a value, i.e. "1234 kB" or "0\t0\t0".
+ * The rest of the value is returned through the remaining view.
+ */
+template <typename T>
+bool ParseNumber(std::string_view &value, T &result) noexcept {
+  auto start = value.find_first_not_of(BLANKS);
+  if (start == std::string_view::npos) {
+    return false;
+  }
+  value.remove_prefix(start);
+  auto [ptr, ec] =
+      std::from_chars(value.data(), value.data() + value.size(), result);
+  if (ec != std::errc()) {
+    return false;
+  }
+  value.remove_prefix(ptr - value.data());
+  return true;
+}
+
+template <typename T> bool ParseScalar(std::string_view value, T &result) {
+  return ParseNumber(value, result);
+}
+
+bool ParseIds(std::string_view value, std::array<unsigned int, 4> &ids) {
+  for (auto &id : ids) {
+    if (!ParseNumber(value, id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Store the value of a single status line.
+ * The key is matched against the hash first and then compared for real,
+ * an unknown key with a colliding hash must not overwrite a field.
+ *
+ * @return true if the line was the Uid line.
+ */
+bool ParseLine(std::string_view key, std::string_view value,
+               ProcessStatus &status) noexcept {
+  auto is = [&key](std::string_view expected) { return key == expected; };
+  switch (StatusKeyHash(key)) {
+  case StatusKeyHash("Name"): {
+    if (is("Name")) {
+      auto name = util::trimmed(value);
+      status.name_length = std::min(name.size(), ProcessStatus::NAME_SIZE);
+      std::copy_n(name.data(), status.name_length, status.name.data());
+    }
+    break;
+  }
+  case StatusKeyHash("State"): {
+    auto state = util::trimmed(value);
+    if (is("State") && !state.empty()) {
+      status.state = state[0];
+    }
+    break;
+  }
+  case StatusKeyHash("Tgid"):
+    is("Tgid") && ParseScalar(value, status.tgid);
+    break;
+  case StatusKeyHash("Pid"):
+    is("Pid") && ParseScalar(value, status.pid);
+    break;
+  case StatusKeyHash("PPid"):
+    is("PPid") && ParseScalar(value, status.ppid);
+    break;
+  case StatusKeyHash("TracerPid"):
+    is("TracerPid") && ParseScalar(value, status.tracer_pid);
+    break;
+  case StatusKeyHash("Uid"):
+    return is("Uid") && ParseIds(value, status.uid);
+  case StatusKeyHash("Gid"):
+    is("Gid") && ParseIds(value, status.gid);
+    break;
+  case StatusKeyHash("FDSize"):
+    is("FDSize") && ParseScalar(value, status.fd_size);
+    break;
+  case StatusKeyHash("VmPeak"):
+    is("VmPeak") && ParseScalar(value, status.vm_peak);
+    break;
+  case StatusKeyHash("VmSize"):
+    is("VmSize") && ParseScalar(value, status.vm_size);
+    break;
+  case StatusKeyHash("VmLck"):
+    is("VmLck") && ParseScalar(value, status.vm_lck);
+    break;
+  case StatusKeyHash("VmPin"):
+    is("VmPin") && ParseScalar(value, status.vm_pin);
+    break;
+  case StatusKeyHash("VmHWM"):
+    is("VmHWM") && ParseScalar(value, status.vm_hwm);
+    break;
+  case StatusKeyHash("VmRSS"):
+    is("VmRSS") && ParseScalar(value, status.vm_rss);
+    break;
+  case StatusKeyHash("RssAnon"):
+    is("RssAnon") && ParseScalar(value, status.rss_anon);
+    break;
+  case StatusKeyHash("RssFile"):
+    is("RssFile") && ParseScalar(value, status.rss_file);
+    break;
+  case StatusKeyHash("RssShmem"):
+    is("RssShmem") && ParseScalar(value, status.rss_shmem);
+    break;
+  case StatusKeyHash("VmData"):
+    is("VmData") && ParseScalar(value, status.vm_data);
+    break;
+  case StatusKeyHash("VmStk"):
+    is("VmStk") && ParseScalar(value, status.vm_stk);
+    break;
+  case StatusKeyHash("VmExe"):
+    is("VmExe") && ParseScalar(value, status.vm_exe);
+    break;
+  case StatusKeyHash("VmLib"):
+    is("VmLib") && ParseScalar(value, status.vm_lib);
+    break;
+  case StatusKeyHash("VmPTE"):
+    is("VmPTE") && ParseScalar(value, status.vm_pte);
+    break;
+  case StatusKeyHash("VmSwap"):
+    is("VmSwap") && ParseScalar(value, status.vm_swap);
+    break;
+  case StatusKeyHash("Threads"):
+    is("Threads") && ParseScalar(value, status.threads);
+    break;
+  case StatusKeyHash("voluntary_ctxt_switches"):
+    is("voluntary_ctxt_switches") &&
+        ParseScalar(value, status.voluntary_ctxt_switches);
+    break;
+  case StatusKeyHash("nonvoluntary_ctxt_switches"):
+    is("nonvoluntary_ctxt_switches") &&
+        ParseScalar(value, status.nonvoluntary_ctxt_switches);
+    break;
+  default:
+    break;
+  }
+  return false;
+}
+} // namespace
+
+std::optional<ProcessStatus>
+ParseProcessStatus(std::string_view content) noexcept {
+  ProcessStatus status;
+  bool has_uid{false};
+  while (!content.empty()) {
+    auto eol = std::min(content.find('\n'), content.size());
+    auto line = content.substr(0, eol);
+    content.remove_prefix(std::min(eol + 1, content.size()));
+    auto separator = line.find(':');
+    if (separator == std::string_view::npos) {
+      continue;
+    }
+    has_uid |= ParseLine(line.substr(0, separator),
+                         line.substr(separator + 1), status);
+  }
+  if (!has_uid) {
+    return std::nullopt;
+  }
+  return status;
+}
+
+std::optional<ProcessStatus>
+ReadProcessStatus(const std::filesystem::path &process_dir) {
+  std::filesystem::path path{process_dir};
+  path += kStatusFilename;
+  auto content = ProcFs::Read(AT_FDCWD, path.c_str());
+  if (content == std::nullopt) {
+    return std::nullopt;
+  }
+  return ParseProcessStatus(content.value());
+}
+
+std::optional<ProcessStatus> ReadProcessStatus(int pid) {
+  auto content = ProcFs::ReadPid(pid, "status");
+  if (content == std::nullopt) {
+    return std::nullopt;
+  }
+  return ParseProcessStatus(content.value());
+}
+} // namespace LinuxParser
@@ -0,0 +1,178 @@
+#include "process_table.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+/**
+ * @brief Put the top rows first, ordered, and copy their indexes in order.
+ * Keys are (value, row) pairs: the rows are in pid order, so the row breaks
+ * the ties by pid.
+ */
+template <typename Key>
+void SelectTop(std::vector<std::pair<Key, std::size_t>> &keys,
+               bool descending, std::size_t top,
+               std::vector<std::size_t> &order) {
+  auto compare = [descending](const auto &a, const auto &b) {
+    if (a.first != b.first) {
+      return descending ? b.first < a.first : a.first < b.first;
+    }
+    return a.second < b.second;
+  };
+  top = std::min(top, keys.size());
+  auto last = keys.begin() + top;
+  if (top < keys.size()) {
+    std::nth_element(keys.begin(), last, keys.end(), compare);
+  }
+  std::partial_sort(keys.begin(), last, last, compare);
+  order.clear();
+  for (const auto &key : keys) {
+    order.push_back(key.second);
+  }
+}
+} // namespace
+
+void ProcessTable::Clear() noexcept {
+  order_.clear();
+  thread_.clear();
+  threads_ = 0;
+  pid_.clear();
+  cpu_.clear();
+  uptime_.clear();
+  user_.clear();
+  command_.clear();
+  vsz_.clear();
+  rss_.clear();
+  text_.clear();
+  texts_.clear();
+}
+
+void ProcessTable::Reserve(std::size_t rows) {
+  pid_.reserve(rows);
+  thread_.reserve(rows);
+  cpu_.reserve(rows);
+  uptime_.reserve(rows);
+  user_.reserve(rows);
+  command_.reserve(rows);
+  vsz_.reserve(rows);
+  rss_.reserve(rows);
+}
+
+void ProcessTable::Append(const Process &process) {
+  order_.push_back(pid_.size());
+  pid_.push_back(process.Pid());
+  thread_.push_back(process.IsThread());
+  threads_ += process.IsThread() ? 1 : 0;
+  cpu_.push_back(process.CpuUtilization());
+  uptime_.push_back(process.UpTime());
+  vsz_.push_back(process.Vsz());
+  rss_.push_back(process.Rss());
+  // few users and many identical commands (worker pools): stored once.
+  user_.push_back(Store(process.user_));
+  command_.push_back(Store(process.command_));
+}
+
+ProcessTable::Text ProcessTable::Store(StringPool::Handle handle) {
+  auto [found, inserted] = texts_.try_emplace(handle);
+  if (inserted) {
+    auto view = handle.View();
+    found->second = Text{static_cast<std::uint32_t>(text_.size()),
+                         static_cast<std::uint32_t>(view.size())};
+    text_.insert(text_.end(), view.begin(), view.end());
+  }
+  return found->second;
+}
+
+void ProcessTable::Assign(const ProcessTable &other) {
+  if (this == &other) {
+    return;
+  }
+  Clear();
+  // vectors keep their capacity on assignment.
+  pid_ = other.pid_;
+  thread_ = other.thread_;
+  threads_ = other.threads_;
+  cpu_ = other.cpu_;
+  uptime_ = other.uptime_;
+  vsz_ = other.vsz_;
+  rss_ = other.rss_;
+  order_ = other.order_;
+  // the strings are ranges of text_, nothing to intern again. The handles
+  // are left behind: a string appended to the copy is stored again.
+  user_ = other.user_;
+  command_ = other.command_;
+  text_ = other.text_;
+}
+
+void ProcessTable::Sort(SortKey key, bool descending, std::size_t top) {
+  if (threads_ == 0) {
+    // back to the order of the rows, left by a previous sort.
+    std::iota(order_.begin(), order_.end(), 0);
+    SortRows(order_, key, descending, top, order_);
+    return;
+  }
+  // the processes are ordered, then each one is followed by its threads.
+  roots_.clear();
+  for (std::size_t row = 0; row < Size(); ++row) {
+    if (!thread_[row]) {
+      roots_.push_back(row);
+    }
+  }
+  SortRows(roots_, key, descending, top, roots_);
+  order_.clear();
+  for (std::size_t rank = 0; rank < roots_.size(); ++rank) {
+    auto root = roots_[rank];
+    order_.push_back(root);
+    // the threads are the rows after their process.
+    children_.clear();
+    for (auto row = root + 1; row < Size() && thread_[row]; ++row) {
+      children_.push_back(row);
+    }
+    if (rank < top) {
+      SortRows(children_, key, descending, children_.size(), children_);
+    }
+    order_.insert(order_.end(), children_.begin(), children_.end());
+  }
+}
+
+void ProcessTable::SortRows(const std::vector<std::size_t> &rows, SortKey key,
+                            bool descending, std::size_t top,
+                            std::vector<std::size_t> &order) {
+  if (key == SortKey::kPid && !descending) {
+    // the rows are filled in pid order, no sort at all.
+    if (&rows != &order) {
+      order = rows;
+    }
+    return;
+  }
+  if (key == SortKey::kUser || key == SortKey::kCommand) {
+    const auto &column = key == SortKey::kUser ? user_ : command_;
+    text_keys_.clear();
+    for (auto row : rows) {
+      text_keys_.emplace_back(View(column[row]), row);
+    }
+    SelectTop(text_keys_, descending, top, order);
+    return;
+  }
+  numeric_keys_.clear();
+  for (auto row : rows) {
+    double value{0};
+    switch (key) {
+    case SortKey::kCpu:
+      value = cpu_[row];
+      break;
+    case SortKey::kMemory:
+      // the memory on the screen.
+      value = vsz_[row];
+      break;
+    case SortKey::kTime:
+      value = uptime_[row];
+      break;
+    default:
+      value = pid_[row];
+      break;
+    }
+    numeric_keys_.emplace_back(value, row);
+  }
+  SelectTop(numeric_keys_, descending, top, order);
+}
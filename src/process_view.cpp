@@ -0,0 +1,79 @@
+#include "process_view.h"
+
+#include <algorithm>
+
+ProcessView::ProcessView(std::size_t height) : height_(height) {}
+
+void ProcessView::Update(const ProcessTable &processes) {
+  table_.Assign(processes);
+  Order();
+}
+
+void ProcessView::SortBy(SortKey key) {
+  if (key == key_) {
+    descending_ = !descending_;
+  } else {
+    key_ = key;
+    // the heaviest first, the names in alphabetical order.
+    descending_ = key != SortKey::kPid && key != SortKey::kUser &&
+                  key != SortKey::kCommand;
+  }
+  Order();
+}
+
+void ProcessView::Search(const std::string &query) {
+  query_ = query;
+  offset_ = 0;
+  Order();
+}
+
+void ProcessView::ScrollBy(long rows) {
+  if (rows < 0) {
+    auto up = static_cast<std::size_t>(-rows);
+    offset_ = offset_ > up ? offset_ - up : 0;
+  } else {
+    offset_ += static_cast<std::size_t>(rows);
+  }
+  Clamp();
+  Order();
+}
+
+void ProcessView::ScrollTo(std::size_t offset) {
+  offset_ = offset;
+  Clamp();
+  Order();
+}
+
+void ProcessView::SetHeight(std::size_t height) {
+  height_ = height;
+  Clamp();
+  Order();
+}
+
+std::size_t ProcessView::Visible() const noexcept {
+  return std::min(height_, rows_.size() - std::min(offset_, rows_.size()));
+}
+
+void ProcessView::Order() {
+  // without a search only the rows up to the screen need to be ordered.
+  auto top = query_.empty() ? offset_ + height_ : table_.Size();
+  table_.Sort(key_, descending_, top);
+  const auto &order = table_.Order();
+  if (query_.empty()) {
+    rows_ = order;
+  } else {
+    rows_.clear();
+    for (auto row : order) {
+      if (table_.Command(row).find(query_) != std::string_view::npos ||
+          table_.User(row).find(query_) != std::string_view::npos) {
+        rows_.push_back(row);
+      }
+    }
+  }
+  Clamp();
+}
+
+void ProcessView::Clamp() noexcept {
+  auto rows = rows_.size();
+  offset_ = std::min(offset_, rows > height_ ? rows - height_ : 0);
+}
@@ -4,11 +4,11 @@
 #include <cmath>
 #include <filesystem>
 
-#include "cpu_sampler.h"
+#include "cpu_monitor.h"
 #include "linux_parser.h"
 #include "util.h"
-using util::ltrim;
-using util::rtrim;
+using util::parse_prefix;
+using util::split_view;
 
 std::optional<std::vector<Processor>> DetectProcessor::GetSystemProcessors() {
   // the logic here is quite simple
@@ -36,15 +36,10 @@ std::optional<std::vector<Processor>> DetectProcessor::GetSystemProcessors() {
   }
   return current_processors;
 }
-std::tuple<std::string, std::string>
-DetectProcessor::ParseLine(const std::string &line) {
-  auto current{line};
-  auto separator = current.find_first_of(":");
-  auto name = line.substr(0, separator);
-  auto value = line.substr(separator + 1);
-  rtrim(name);
-  ltrim(value);
-  return std::make_tuple(name, value);
+std::pair<std::string_view, std::string_view>
+DetectProcessor::ParseLine(std::string_view line) {
+  // name\t: value, both parts trimmed without copies.
+  return split_view(line, ":");
 }
 std::optional<Processor>
 DetectProcessor::CreateProcessor(std::ifstream &dataFile) {
@@ -52,22 +47,17 @@ DetectProcessor::CreateProcessor(std::ifstream &dataFile) {
   Processor proc;
   // we use this for reading the three value to be read and just those.
   int state{0};
-  std::vector<std::string> infos{"model name", "cpu MHz", "cache size"};
   while (std::getline(dataFile, current) && (state < 3)) {
     auto [name, value] = DetectProcessor::ParseLine(current);
-    if (current.find(infos[0]) != std::string::npos) {
+    if (name == "model name") {
       proc.modelName_ = value;
       state++;
-    }
-    if (current.find(infos[1]) != std::string::npos) {
-      proc.frequency_ = std::round(std::stof(value));
+    } else if (name == "cpu MHz") {
+      proc.frequency_ = std::round(parse_prefix<float>(value).value_or(0.0f));
       state++;
-    }
-    if (current.find(infos[2]) != std::string::npos) {
-      auto pos = value.find("KB");
-      value.replace(pos, value.length(), "");
-      rtrim(value);
-      proc.cacheSize_ = std::stoi(value);
+    } else if (name == "cache size") {
+      // i.e. 3072 KB
+      proc.cacheSize_ = parse_prefix<int>(value).value_or(0);
       state++;
     }
   }
@@ -77,11 +67,6 @@ int Processor::CacheSize() const { return cacheSize_; }
 float Processor::Frequency() const { return frequency_; }
 std::string Processor::ModelName() const { return modelName_; }
 float Processor::Utilization() {
-  float cpuUsage{0.0};
-  LinuxParser::CPUSampler sampler(CPU_SAMPLES, [&cpuUsage](float currentValue) {
-    cpuUsage = currentValue;
-  });
-  sampler.Sample();
-  cpuUsage /= 100;
-  return cpuUsage;
-}
\ No newline at end of file
+  // the monitor samples in background, here we just read the last median.
+  return LinuxParser::CPUMonitor::Instance().Median() / 100;
+}
@@ -0,0 +1,255 @@
+#include "procfs.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace LinuxParser {
+namespace {
+// most of the files in /proc fit here, the buffer grows for the others.
+constexpr std::size_t INITIAL_BUFFER_SIZE{4096};
+// a getdents64 call returns ~1500 entries of /proc.
+constexpr std::size_t DIRENT_BUFFER_SIZE{64 * 1024};
+
+// layout of the records returned by getdents64, glibc doesn't export it.
+struct LinuxDirent64 {
+  ino64_t d_ino;
+  off64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+
+/**
+ * @brief Parse the name of a /proc entry as a pid.
+ * There are no branches on the characters: a non digit just marks the
+ * name as invalid, so the loop runs the same for every entry.
+ *
+ * @return pid_t the pid, or -1 if the name isn't a number.
+ */
+pid_t ParsePid(const char *name) noexcept {
+  unsigned int invalid{name[0] == '\0'};
+  pid_t pid{0};
+  for (; *name != '\0'; ++name) {
+    unsigned int digit = static_cast<unsigned char>(*name) - '0';
+    invalid |= digit > 9;
+    pid = pid * 10 + static_cast<pid_t>(digit);
+  }
+  return invalid ? -1 : pid;
+}
+
+/**
+ * @brief Collect the numeric directories of an open directory with
+ * getdents64, in a large buffer of the thread. The result is sorted.
+ */
+void ListDirectory(int fd, std::vector<pid_t> &pids) {
+  thread_local std::vector<char> buffer(DIRENT_BUFFER_SIZE);
+  while (true) {
+    auto count = ::syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+    if (count <= 0) {
+      break;
+    }
+    for (long offset = 0; offset < count;) {
+      const auto *entry =
+          reinterpret_cast<const LinuxDirent64 *>(buffer.data() + offset);
+      offset += entry->d_reclen;
+      if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) {
+        continue;
+      }
+      auto pid = ParsePid(entry->d_name);
+      if (pid > 0) {
+        pids.push_back(pid);
+      }
+    }
+  }
+  // /proc lists the pids in order, the sort is almost free.
+  std::sort(pids.begin(), pids.end());
+}
+
+/**
+ * @brief Cache of the open /proc/PID directories.
+ * It never uses more than half of the file descriptors that the process
+ * can open: beyond the budget the directories are opened for each read.
+ * The map is shared between threads, but a pid is read by one thread at
+ * a time and the exited ones are dropped between two refreshes.
+ */
+class PidDirCache final {
+public:
+  PidDirCache() {
+    rlimit limit{};
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 &&
+        limit.rlim_cur != RLIM_INFINITY) {
+      budget_ = limit.rlim_cur / 2;
+    }
+  }
+  ~PidDirCache() {
+    for (auto [pid, fd] : dirs_) {
+      ::close(fd);
+    }
+  }
+  // returns the cached descriptor or -1.
+  int Find(int pid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto dir = dirs_.find(pid);
+    return dir == dirs_.end() ? -1 : dir->second;
+  }
+  // try to keep the descriptor, false if the caller has to close it.
+  bool Insert(int pid, int fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirs_.size() >= budget_) {
+      return false;
+    }
+    auto [dir, inserted] = dirs_.try_emplace(pid, fd);
+    if (!inserted) {
+      // another thread has been faster or the entry was stale.
+      ::close(dir->second);
+      dir->second = fd;
+    }
+    return true;
+  }
+  void Erase(int pid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto dir = dirs_.find(pid);
+    if (dir != dirs_.end()) {
+      ::close(dir->second);
+      dirs_.erase(dir);
+    }
+  }
+  void Retain(const std::vector<int> &pids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto dir = dirs_.begin(); dir != dirs_.end();) {
+      if (!std::binary_search(pids.begin(), pids.end(), dir->first)) {
+        ::close(dir->second);
+        dir = dirs_.erase(dir);
+      } else {
+        ++dir;
+      }
+    }
+  }
+  std::size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dirs_.size();
+  }
+
+private:
+  std::size_t budget_{512};
+  std::unordered_map<int, int> dirs_;
+  std::mutex mutex_;
+};
+
+PidDirCache &Cache() {
+  static PidDirCache cache;
+  return cache;
+}
+
+// read the content of an open file in the buffer of the thread.
+std::optional<std::string_view> ReadAll(int fd) {
+  thread_local std::string buffer(INITIAL_BUFFER_SIZE, '\0');
+  std::size_t size{0};
+  while (true) {
+    auto count = ::pread(fd, buffer.data() + size, buffer.size() - size, size);
+    if (count < 0) {
+      return std::nullopt;
+    }
+    if (count == 0) {
+      break;
+    }
+    size += count;
+    if (size == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+  }
+  return std::string_view(buffer.data(), size);
+}
+} // namespace
+
+int ProcFs::ProcDir() {
+  static int fd = ::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  return fd;
+}
+
+std::optional<std::string_view> ProcFs::Read(int dirfd, const char *path) {
+  int fd = ::openat(dirfd, path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  auto content = ReadAll(fd);
+  ::close(fd);
+  return content;
+}
+
+std::optional<std::string_view> ProcFs::Read(const char *name) {
+  return Read(ProcDir(), name);
+}
+
+std::optional<std::string_view> ProcFs::ReadPid(int pid, const char *name) {
+  auto cached = Cache().Find(pid);
+  if (cached >= 0) {
+    auto content = Read(cached, name);
+    if (content != std::nullopt) {
+      return content;
+    }
+    // the cached directory belongs to an exited process, the pid could
+    // have been reused: we drop it and try once a fresh one.
+    Cache().Erase(pid);
+  }
+  char dir_name[16]{};
+  std::to_chars(dir_name, dir_name + sizeof(dir_name) - 1, pid);
+  int fd = ::openat(ProcDir(), dir_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  auto content = Read(fd, name);
+  // callers look at errno for telling why the read failed.
+  auto error = errno;
+  if (!Cache().Insert(pid, fd)) {
+    // over budget, the directory is not kept.
+    ::close(fd);
+  }
+  errno = error;
+  return content;
+}
+
+std::vector<pid_t> ProcFs::Pids() {
+  // the offset of the /proc descriptor is shared: one listing at a time.
+  static std::mutex mutex;
+  std::vector<pid_t> pids;
+  std::lock_guard<std::mutex> lock(mutex);
+  int fd = ProcDir();
+  if (fd < 0 || ::lseek(fd, 0, SEEK_SET) < 0) {
+    return pids;
+  }
+  ListDirectory(fd, pids);
+  return pids;
+}
+
+std::vector<pid_t> ProcFs::Tids(int pid) {
+  std::vector<pid_t> tids;
+  char path[32]{};
+  auto end = std::to_chars(path, path + sizeof(path) - 1, pid).ptr;
+  std::string_view task{"/task"};
+  std::copy(task.begin(), task.end(), end);
+  int fd = ::openat(ProcDir(), path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    return tids;
+  }
+  ListDirectory(fd, tids);
+  ::close(fd);
+  return tids;
+}
+
+void ProcFs::RetainPids(const std::vector<int> &pids) {
+  Cache().Retain(pids);
+}
+
+std::size_t ProcFs::CachedPids() { return Cache().Size(); }
+} // namespace LinuxParser
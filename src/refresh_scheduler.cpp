@@ -0,0 +1,66 @@
+#include "refresh_scheduler.h"
+
+#include <algorithm>
+
+RefreshScheduler::RefreshScheduler() : RefreshScheduler(Budget{}) {}
+
+RefreshScheduler::RefreshScheduler(Budget budget) : budget_(budget) {}
+
+void RefreshScheduler::Record(RefreshPhase phase, Duration duration) noexcept {
+  auto index = static_cast<std::size_t>(phase);
+  auto value = static_cast<double>(duration.count());
+  if (!measured_[index]) {
+    cost_ns_[index] = value;
+    measured_[index] = true;
+  } else {
+    cost_ns_[index] = COST_ALPHA * value + (1 - COST_ALPHA) * cost_ns_[index];
+  }
+}
+
+RefreshScheduler::Duration
+RefreshScheduler::Cost(RefreshPhase phase) const noexcept {
+  return Duration(
+      static_cast<Duration::rep>(cost_ns_[static_cast<std::size_t>(phase)]));
+}
+
+RefreshScheduler::Duration RefreshScheduler::FrameCost() const noexcept {
+  double total{0};
+  for (auto cost : cost_ns_) {
+    total += cost;
+  }
+  return Duration(static_cast<Duration::rep>(total));
+}
+
+std::chrono::milliseconds RefreshScheduler::Interval() const noexcept {
+  // cost / interval <= cpu_share, rounded up for staying within the share.
+  auto needed = std::chrono::ceil<std::chrono::milliseconds>(
+      FrameCost() / std::max(budget_.cpu_share, 1e-6));
+  return std::clamp(needed, budget_.min_interval, budget_.max_interval);
+}
+
+void RefreshScheduler::EndRefresh() noexcept {
+  auto cost = FrameCost();
+  if (cost > budget_.frame) {
+    // over budget: the idle processes first, then the slow data.
+    if (idle_stride_ < MAX_STRIDE) {
+      idle_stride_ *= 2;
+    } else {
+      slow_stride_ = std::min(slow_stride_ * 2, MAX_STRIDE);
+    }
+  } else if (cost < budget_.frame / 2) {
+    if (slow_stride_ > SLOW_DATA_STRIDE) {
+      slow_stride_ = std::max(slow_stride_ / 2, SLOW_DATA_STRIDE);
+    } else {
+      idle_stride_ = std::max(idle_stride_ / 2, 1u);
+    }
+  }
+  ++refreshes_;
+}
+
+bool RefreshScheduler::SlowDataDue() const noexcept {
+  return refreshes_ % slow_stride_ == 0;
+}
+
+bool RefreshScheduler::SampleDue(int pid) const noexcept {
+  return (refreshes_ + static_cast<unsigned int>(pid)) % idle_stride_ == 0;
+}
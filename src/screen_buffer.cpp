@@ -0,0 +1,64 @@
+#include "screen_buffer.h"
+
+#include <algorithm>
+
+namespace {
+// never written in the back buffer: a front cell holding it is redrawn.
+constexpr char UNKNOWN{'\0'};
+} // namespace
+
+ScreenBuffer::ScreenBuffer(int rows, int columns, int border)
+    : border_(std::max(border, 0)) {
+  Resize(rows, columns);
+  // a new window is blank.
+  front_.assign(back_.size(), ' ');
+}
+
+void ScreenBuffer::Resize(int rows, int columns) {
+  rows_ = std::max(rows, 0);
+  columns_ = std::max(columns, 0);
+  auto cells = static_cast<std::size_t>(rows_) * columns_;
+  back_.assign(cells, ' ');
+  back_colors_.assign(cells, 0);
+  front_colors_.assign(cells, 0);
+  // the border is never written, it's taken as drawn.
+  front_.assign(cells, ' ');
+  Invalidate();
+}
+
+void ScreenBuffer::Clear() noexcept {
+  std::fill(back_.begin(), back_.end(), ' ');
+  std::fill(back_colors_.begin(), back_colors_.end(), 0);
+}
+
+void ScreenBuffer::Invalidate() noexcept {
+  // only the inside of the border, it's never drawn by Flush.
+  for (int row = border_; row < rows_ - border_; ++row) {
+    for (int column = border_; column < columns_ - border_; ++column) {
+      front_[Index(row, column)] = UNKNOWN;
+    }
+  }
+}
+
+void ScreenBuffer::Put(int row, int column, std::string_view text, int width,
+                       short color) noexcept {
+  // the border is left to the box of the window.
+  auto last_column = columns_ - border_;
+  if (row < border_ || row >= rows_ - border_ || column < border_ ||
+      column >= last_column) {
+    return;
+  }
+  if (width < 0) {
+    width = static_cast<int>(text.size());
+  }
+  width = std::min(width, last_column - column);
+  auto length = std::min<std::size_t>(text.size(), width);
+  auto cell = Index(row, column);
+  for (std::size_t i = 0; i < length; ++i) {
+    // a control character would move the cursor of the terminal.
+    auto c = text[i];
+    back_[cell + i] = static_cast<unsigned char>(c) < ' ' ? ' ' : c;
+  }
+  std::fill_n(back_.begin() + cell + length, width - length, ' ');
+  std::fill_n(back_colors_.begin() + cell, width, color);
+}
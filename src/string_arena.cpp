@@ -0,0 +1,44 @@
+#include "string_arena.h"
+
+#include <algorithm>
+
+std::string_view StringArena::Intern(std::string_view value) {
+  auto found = strings_.find(value);
+  if (found != strings_.end()) {
+    return *found;
+  }
+  auto *data = Allocate(value.size());
+  std::copy(value.begin(), value.end(), data);
+  std::string_view stored{data, value.size()};
+  strings_.insert(stored);
+  return stored;
+}
+
+void StringArena::Clear() noexcept {
+  strings_.clear();
+  current_ = 0;
+  used_ = 0;
+}
+
+std::size_t StringArena::Size() const noexcept { return strings_.size(); }
+
+char *StringArena::Allocate(std::size_t size) {
+  if (current_ < blocks_.size() &&
+      used_ + size <= blocks_[current_].capacity) {
+    used_ += size;
+    return blocks_[current_].data.get() + used_ - size;
+  }
+  // the rest of the current block is wasted, look for the next one that
+  // fits (after a Clear the blocks are reused in order).
+  auto next = current_ + (current_ < blocks_.size() && used_ > 0 ? 1 : 0);
+  while (next < blocks_.size() && blocks_[next].capacity < size) {
+    ++next;
+  }
+  if (next == blocks_.size()) {
+    auto capacity = std::max(size, BLOCK_SIZE);
+    blocks_.push_back({std::make_unique<char[]>(capacity), capacity});
+  }
+  current_ = next;
+  used_ = size;
+  return blocks_[current_].data.get();
+}
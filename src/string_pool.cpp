@@ -0,0 +1,91 @@
+#include "string_pool.h"
+
+StringPool::StringPool() : arena_(std::make_unique<StringArena>()) {}
+
+StringPool &StringPool::Shared() {
+  static StringPool pool;
+  return pool;
+}
+
+StringPool::Handle StringPool::Intern(std::string_view text) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = index_.find(text);
+  if (found != index_.end()) {
+    found->second->generation = generation_;
+    return Handle(found->second);
+  }
+  Entry *entry{nullptr};
+  if (free_.empty()) {
+    entry = &entries_.emplace_back();
+  } else {
+    entry = free_.back();
+    free_.pop_back();
+  }
+  entry->text = arena_->Intern(text);
+  entry->generation = generation_;
+  index_.emplace(entry->text, entry);
+  return Handle(entry);
+}
+
+void StringPool::NextGeneration() noexcept {
+  ++generation_;
+  ++epoch_;
+}
+
+void StringPool::Mark(Handle handle) noexcept {
+  if (handle.entry_ != nullptr) {
+    handle.entry_->generation = generation_;
+  }
+}
+
+void StringPool::Sweep() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the handles in the caches may be dropped or moved.
+  ++epoch_;
+  for (auto entry = index_.begin(); entry != index_.end();) {
+    if (entry->second->generation != generation_) {
+      free_.push_back(entry->second);
+      entry = index_.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+  // the dead strings are still in the arena, reused if they come back.
+  auto garbage = arena_->Size() - index_.size();
+  if (garbage >= MIN_GARBAGE && garbage > index_.size()) {
+    Compact();
+  }
+}
+
+std::size_t StringPool::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.size();
+}
+
+void StringPool::Compact() {
+  auto arena = std::make_unique<StringArena>();
+  std::unordered_map<std::string_view, Entry *> index;
+  index.reserve(index_.size());
+  for (auto [text, entry] : index_) {
+    entry->text = arena->Intern(text);
+    index.emplace(entry->text, entry);
+  }
+  arena_ = std::move(arena);
+  index_ = std::move(index);
+}
+
+StringPool::Handle StringPool::Cache::Intern(std::string_view text) {
+  // the owner changes the epoch only while nobody interns.
+  if (epoch_ != pool_->epoch_) {
+    handles_.clear();
+    epoch_ = pool_->epoch_;
+  }
+  auto found = handles_.find(text);
+  if (found != handles_.end()) {
+    // interned in this generation, so already marked.
+    return found->second;
+  }
+  auto handle = pool_->Intern(text);
+  handles_.emplace(handle.View(), handle);
+  return handle;
+}
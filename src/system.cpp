@@ -2,36 +2,71 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <filesystem>
+#include <iterator>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "cpu_monitor.h"
 #include "linux_parser.h"
 #include "process.h"
 #include "processor.h"
+#include "procfs.h"
+#include "user_directory.h"
 #include "util.h"
 
 using std::set;
 using std::size_t;
 using std::string;
 using std::vector;
-using util::ltrim;
-using util::rtrim;
-using util::scan_pid;
-using util::splitInTwo;
-using util::to_float;
-using util::to_integral;
 /**
  * @brief Construct a new System
  * Here we call some functions for loading values.
  * We load first immutable values.
+ *
+ * @param workers threads building the processes, 0 for one per online cpu.
  */
-System::System() {
+System::System(std::size_t workers)
+    : pool_(workers > 0 ? workers : CpuTopology::Current()->OnlineCpus()),
+      buffers_(pool_.Size()),
+      caches_(pool_.Size(), StringPool::Cache{strings_}) {
   // we initialize the values.
   DetectKernelVersion();
+  topology_ = CpuTopology::Current();
+  DetectCpu();
+  DetectOperatingSystem();
+  // load the users once, processes share the directory.
+  UserDirectory::Instance().Refresh();
+  Refresh();
+}
+/**
+ * @brief Capture /proc/stat for the current refresh.
+ * If the read fails we keep the previous snapshot.
+ */
+void System::Refresh() {
+  RefreshScheduler::Measure measure{scheduler_, RefreshPhase::kSystem};
+  auto snapshot = LinuxParser::ReadSystemStat();
+  if (snapshot != std::nullopt) {
+    system_stat_ = std::move(snapshot.value());
+  }
+  // listed once, shared by TotalProcesses and Processes.
+  pids_ = LinuxParser::Pids();
+  // cpuinfo (i.e. the frequency) and the topology seldom change, the
+  // constructor has just read them for the first refresh.
+  if (scheduler_.SlowDataDue() && scheduler_.Refreshes() > 0) {
+    RefreshTopology();
+    DetectCpu();
+  }
+}
+/**
+ * @brief Read the descriptor of the first cpu from /proc/cpuinfo.
+ */
+void System::DetectCpu() {
   auto result = DetectProcessor::GetSystemProcessors();
   if (result != std::nullopt) {
     auto coresArray = result.value();
@@ -39,7 +74,6 @@ System::System() {
       cpu_ = coresArray[0];
     }
   }
-  DetectOperatingSystem();
 }
 /**
  * @brief Return the CPU
@@ -49,22 +83,220 @@ System::System() {
 
 Processor &System::Cpu() { return cpu_; }
 
-/*
+const CpuTopology &System::Topology() const { return *topology_; }
+
+/**
+ * @brief Utilization of each core sampled by the background monitor.
+ *
+ * @return std::vector<float> utilization fraction of each core.
+ */
+std::vector<float> System::CoreUtilization() const {
+  auto cores = LinuxParser::CPUMonitor::Instance().CoreUtilization();
+  std::vector<float> utilization(cores->begin(), cores->end());
+  for (auto &core : utilization) {
+    core /= 100;
+  }
+  return utilization;
+}
+
+void System::RefreshTopology() { topology_ = CpuTopology::Refresh(); }
+
+/**
+ * @brief Refresh the processes incrementally.
+ * The pids of this refresh are merged with the processes of the previous
+ * one (both are sorted by pid): the exited processes are dropped, the new
+ * ones are built from scratch and the others re-read just stat and statm.
+ *
+ * @return vector<Process>& the processes sorted by pid.
  */
-// TODO: Return a container composed of the system's processes
 vector<Process> &System::Processes() {
-  std::filesystem::path base{LinuxParser::kProcDirectory};
-  processes_.clear();
-  auto processes = LinuxParser::Pids();
-  for (const auto &process : processes) {
-    auto current_proc = base;
-    current_proc += std::to_string(process);
-    auto process_data = ProcessBuilder::Build(current_proc);
-    processes_.emplace_back(process_data);
+  {
+    RefreshScheduler::Measure measure{scheduler_, RefreshPhase::kProcesses};
+    UpdateProcesses();
+  }
+  {
+    RefreshScheduler::Measure measure{scheduler_, RefreshPhase::kThreads};
+    CollectThreads();
   }
+  FillTable();
+  scheduler_.EndRefresh();
   return processes_;
 }
 
+/**
+ * @brief Merge the pids with the processes of the previous refresh and
+ * read what has changed. The idle processes are read only when the
+ * scheduler says so, the command lines only with the slow data.
+ */
+void System::UpdateProcesses() {
+  auto slow_data = scheduler_.SlowDataDue();
+  // it's just a stat of /etc/passwd unless users have been changed, then
+  // the cached user names could be stale and we build everything again.
+  if (slow_data && UserDirectory::Instance().Refresh()) {
+    processes_.clear();
+  }
+  // the strings of the processes that are gone are collected at the end.
+  strings_.NextGeneration();
+  const auto &pids = pids_;
+  // the directories of the exited processes are not needed anymore.
+  LinuxParser::ProcFs::RetainPids(pids);
+
+  vector<Process> survivors;
+  vector<int> fresh;
+  survivors.reserve(processes_.size());
+  auto previous = processes_.begin();
+  for (auto pid : pids) {
+    // the processes before pid have exited.
+    while (previous != processes_.end() && previous->Pid() < pid) {
+      ++previous;
+    }
+    if (previous != processes_.end() && previous->Pid() == pid) {
+      survivors.emplace_back(std::move(*previous++));
+    } else {
+      fresh.push_back(pid);
+    }
+  }
+  processes_.clear();
+
+  // every worker fills its own buffer and interns through its own cache, no
+  // lock while building; the cpu usage is computed by FillTable. A survivor
+  // that can't be updated has exited or its pid has been reused: it's
+  // built again, as a new process.
+  vector<char> updated(survivors.size(), false);
+  // processes exiting during the scan are just dropped and counted.
+  std::atomic<std::size_t> dropped{0};
+  std::atomic<std::size_t> skipped{0};
+  auto build = [&](int pid, std::size_t worker) {
+    auto process = ProcessBuilder::TryBuild(pid, caches_[worker]);
+    if (process) {
+      buffers_[worker].emplace_back(std::move(process).value());
+    } else {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+  auto update = [&](Process &process, std::size_t worker) {
+    if (process.IdleRefreshes() >= RefreshScheduler::IDLE_REFRESHES &&
+        !scheduler_.SampleDue(process.Pid())) {
+      ProcessBuilder::Skip(process);
+      skipped.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    return ProcessBuilder::Update(process,
+                                  slow_data ? &caches_[worker] : nullptr);
+  };
+  pool_.ParallelFor(survivors.size() + fresh.size(), PROCESSES_PER_TASK,
+                    [&](std::size_t index, std::size_t worker) {
+                      if (index >= survivors.size()) {
+                        build(fresh[index - survivors.size()], worker);
+                      } else if (update(survivors[index], worker)) {
+                        updated[index] = true;
+                      } else {
+                        build(survivors[index].Pid(), worker);
+                      }
+                    });
+  for (std::size_t index = 0; index < survivors.size(); ++index) {
+    if (updated[index]) {
+      processes_.emplace_back(std::move(survivors[index]));
+    }
+  }
+  refresh_stats_.updated = processes_.size();
+  refresh_stats_.dropped = dropped.load();
+  refresh_stats_.skipped = skipped.load();
+  for (auto &buffer : buffers_) {
+    std::move(buffer.begin(), buffer.end(), std::back_inserter(processes_));
+    buffer.clear();
+  }
+  refresh_stats_.built = processes_.size() - refresh_stats_.updated;
+  // back in pid order, as they are in /proc.
+  std::sort(processes_.begin(), processes_.end());
+}
+
+/**
+ * @brief Compute the cpu usage and copy the processes, and their threads,
+ * in the table.
+ */
+void System::FillTable() {
+  // cpu usage is the delta with the previous refresh.
+  cpu_tracker_.BeginTick(system_stat_.cpu.Total(), topology_->OnlineCpus());
+  // the tracker isn't shared between threads, it's a cheap pass.
+  table_.Clear();
+  table_.Reserve(processes_.size() + threads_.size());
+  auto thread = threads_.begin();
+  for (auto &process : processes_) {
+    ProcessBuilder::UpdateCpuUsage(process, cpu_tracker_);
+    ProcessBuilder::MarkStrings(process, strings_);
+    table_.Append(process);
+    // the threads follow their process.
+    for (; thread != threads_.end() && thread->Tgid() == process.Pid();
+         ++thread) {
+      ProcessBuilder::UpdateCpuUsage(*thread, thread_tracker_);
+      ProcessBuilder::MarkStrings(*thread, strings_);
+      table_.Append(*thread);
+    }
+  }
+  cpu_tracker_.EndTick();
+  if (threads_mode_) {
+    thread_tracker_.EndTick();
+  }
+  strings_.Sweep();
+}
+
+/**
+ * @brief Build the threads of all the processes, in parallel. Each task
+ * lists and reads the threads of PROCESSES_PER_TASK processes: a process
+ * with many threads is one slow item that the other workers steal around.
+ */
+void System::CollectThreads() {
+  threads_.clear();
+  refresh_stats_.threads = 0;
+  if (!threads_mode_) {
+    return;
+  }
+  thread_tracker_.BeginTick(system_stat_.cpu.Total(), topology_->OnlineCpus());
+  std::atomic<std::size_t> dropped{0};
+  pool_.ParallelFor(
+      processes_.size(), PROCESSES_PER_TASK,
+      [&](std::size_t index, std::size_t worker) {
+        const auto &process = processes_[index];
+        for (auto tid : LinuxParser::ProcFs::Tids(process.Pid())) {
+          auto thread =
+              ProcessBuilder::TryBuildThread(process, tid, caches_[worker]);
+          if (thread) {
+            buffers_[worker].emplace_back(std::move(thread).value());
+          } else {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+  for (auto &buffer : buffers_) {
+    std::move(buffer.begin(), buffer.end(), std::back_inserter(threads_));
+    buffer.clear();
+  }
+  std::sort(threads_.begin(), threads_.end(),
+            [](const Process &a, const Process &b) {
+              return a.Tgid() != b.Tgid() ? a.Tgid() < b.Tgid()
+                                          : a.Pid() < b.Pid();
+            });
+  refresh_stats_.threads = threads_.size();
+  refresh_stats_.dropped += dropped.load();
+}
+
+RefreshScheduler &System::Scheduler() { return scheduler_; }
+
+std::chrono::milliseconds System::RefreshInterval() const {
+  return scheduler_.Interval();
+}
+
+void System::SetThreadsMode(bool enabled) { threads_mode_ = enabled; }
+
+bool System::ThreadsMode() const { return threads_mode_; }
+
+const ProcessTable &System::Table() const { return table_; }
+
+const System::RefreshStats &System::LastRefreshStats() const {
+  return refresh_stats_;
+}
+
 /**
  * @brief Kernel returns the version of the kernel of the current Linux OS.
  *
@@ -80,19 +312,20 @@ float System::MemoryUtilization() { return LinuxParser::MemoryUtilization(); }
 std::string System::OperatingSystem() { return operating_system_; }
 
 // Return the number of processes actively running on the system
+// it comes from the /proc/stat of the current refresh.
 int System::RunningProcesses() {
-  running_processes_ = LoadRunningProcessing();
+  running_processes_ = system_stat_.procs_running;
   return running_processes_;
 }
 
 /**
- * @brief Return the number of total processes scanning /proc directory
+ * @brief Return the number of total processes listed by the last refresh.
  * The proc directory on Linux contains a directory for each process with the
  * pid name. The pid me is just a number
  * @return int the number of processes present in the system.
  */
 int System::TotalProcesses() {
-  total_processes_ = LinuxParser::TotalProcesses();
+  total_processes_ = static_cast<int>(pids_.size());
   return total_processes_;
 }
 
@@ -106,7 +339,6 @@ long int System::UpTime() {
   return uptime_;
 }
 
-int System::LoadRunningProcessing() { return LinuxParser::RunningProcesses(); }
 void System::DetectKernelVersion() { kernel_version_ = LinuxParser::Kernel(); }
 void System::DetectOperatingSystem() {
   operating_system_ = LinuxParser::OperatingSystem();
@@ -0,0 +1,137 @@
+#include "system_stat.h"
+
+#include <algorithm>
+#include <charconv>
+
+#include "procfs.h"
+
+namespace LinuxParser {
+namespace {
+/**
+ * @brief Parse the numbers of a line in order, stops at the first missing.
+ *
+ * @return std::size_t how many numbers have been parsed.
+ */
+std::size_t ParseNumbers(std::string_view line,
+                         std::initializer_list<unsigned long long *> values) {
+  std::size_t parsed{0};
+  for (auto value : values) {
+    auto start = line.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+      break;
+    }
+    line.remove_prefix(start);
+    auto [ptr, ec] =
+        std::from_chars(line.data(), line.data() + line.size(), *value);
+    if (ec != std::errc()) {
+      break;
+    }
+    line.remove_prefix(ptr - line.data());
+    ++parsed;
+  }
+  return parsed;
+}
+
+bool ParseCpuTimes(std::string_view line, CpuTimes &times) {
+  // guest and guest_nice are missing in old kernels.
+  return ParseNumbers(line, {&times.user, &times.nice, &times.system,
+                             &times.idle, &times.iowait, &times.irq,
+                             &times.softirq, &times.steal, &times.guest,
+                             &times.guest_nice}) >= 4;
+}
+void AppendCore(unsigned int id, const CpuTimes &core, CoreTimes &cores) {
+  cores.id.push_back(id);
+  cores.user.push_back(core.user);
+  cores.nice.push_back(core.nice);
+  cores.system.push_back(core.system);
+  cores.idle.push_back(core.idle);
+  cores.iowait.push_back(core.iowait);
+  cores.irq.push_back(core.irq);
+  cores.softirq.push_back(core.softirq);
+  cores.steal.push_back(core.steal);
+}
+} // namespace
+
+void CoreUtilization(const CoreTimes &previous, const CoreTimes &current,
+                     std::vector<float> &utilization) {
+  auto size = current.Size();
+  // after a hotplug the cores don't match anymore: no period to compare.
+  auto common = (previous.id == current.id) ? size : 0;
+  utilization.assign(size, 0.0f);
+  // plain loops over contiguous arrays without branches, the compiler can
+  // vectorize them.
+  for (std::size_t i = 0; i < common; ++i) {
+    auto now = current.user[i] + current.nice[i] + current.system[i] +
+               current.idle[i] + current.iowait[i] + current.irq[i] +
+               current.softirq[i] + current.steal[i];
+    auto before = previous.user[i] + previous.nice[i] + previous.system[i] +
+                  previous.idle[i] + previous.iowait[i] + previous.irq[i] +
+                  previous.softirq[i] + previous.steal[i];
+    // the counters can go backwards (iowait, see proc(5)): no period, 0.
+    auto total = now > before ? now - before : 0;
+    // clamped like the aggregate in the cpu monitor: a decreasing iowait
+    // wraps the idle delta, the core is taken as idle rather than busy.
+    auto idle = std::min((current.idle[i] + current.iowait[i]) -
+                             (previous.idle[i] + previous.iowait[i]),
+                         total);
+    // a zero period gives 0 instead of a division by zero.
+    auto period = static_cast<float>(total) + (total == 0);
+    utilization[i] = static_cast<float>(total - idle) / period;
+  }
+}
+
+std::optional<SystemStatSnapshot> ParseSystemStat(std::string_view content) {
+  SystemStatSnapshot snapshot;
+  bool has_cpu{false};
+  while (!content.empty()) {
+    auto eol = std::min(content.find('\n'), content.size());
+    auto line = content.substr(0, eol);
+    content.remove_prefix(std::min(eol + 1, content.size()));
+    auto separator = line.find(' ');
+    if (separator == std::string_view::npos) {
+      continue;
+    }
+    auto key = line.substr(0, separator);
+    auto values = line.substr(separator);
+    if (key == "cpu") {
+      has_cpu = ParseCpuTimes(values, snapshot.cpu);
+    } else if (key.substr(0, 3) == "cpu") {
+      CpuTimes core;
+      unsigned int id{0};
+      auto number = key.substr(3);
+      auto [ptr, ec] =
+          std::from_chars(number.data(), number.data() + number.size(), id);
+      if (ec == std::errc() && ParseCpuTimes(values, core)) {
+        AppendCore(id, core, snapshot.cores);
+      }
+    } else if (key == "ctxt") {
+      ParseNumbers(values, {&snapshot.ctxt});
+    } else if (key == "btime") {
+      ParseNumbers(values, {&snapshot.btime});
+    } else if (key == "processes") {
+      ParseNumbers(values, {&snapshot.processes});
+    } else if (key == "procs_running") {
+      ParseNumbers(values, {&snapshot.procs_running});
+    } else if (key == "procs_blocked") {
+      ParseNumbers(values, {&snapshot.procs_blocked});
+    } else if (key == "intr") {
+      ParseNumbers(values, {&snapshot.intr});
+    } else if (key == "softirq") {
+      ParseNumbers(values, {&snapshot.softirq});
+    }
+  }
+  if (!has_cpu) {
+    return std::nullopt;
+  }
+  return snapshot;
+}
+
+std::optional<SystemStatSnapshot> ReadSystemStat() {
+  // the intr line can be several KB on big hosts, the buffer grows.
+  auto content = ProcFs::Read("stat");
+  if (content == std::nullopt) {
+    return std::nullopt;
+  }
+  return ParseSystemStat(content.value());
+}
+} // namespace LinuxParser
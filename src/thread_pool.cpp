@@ -0,0 +1,118 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t workers) {
+  workers = std::max<std::size_t>(workers, 1);
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    queues_.emplace_back(std::make_unique<Queue>());
+  }
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    threads_.emplace_back(&ThreadPool::Run, this, worker);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  start_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+std::size_t ThreadPool::Size() const noexcept { return queues_.size(); }
+
+void ThreadPool::ParallelFor(std::size_t count, std::size_t grain,
+                             const Body &body) {
+  if (count == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> loop(loop_);
+  grain = std::max<std::size_t>(grain, 1);
+  auto chunks = (count + grain - 1) / grain;
+  auto workers = Size();
+  // each worker starts from a contiguous block of chunks.
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    auto &queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (auto chunk = worker * chunks / workers;
+         chunk < (worker + 1) * chunks / workers; ++chunk) {
+      queue.ranges.emplace_back(chunk * grain,
+                                std::min(count, (chunk + 1) * grain));
+    }
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  body_ = &body;
+  error_ = nullptr;
+  busy_ = workers;
+  ++generation_;
+  start_.notify_all();
+  done_.wait(lock, [this] { return busy_ == 0; });
+  body_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+void ThreadPool::Run(std::size_t worker) {
+  std::size_t seen{0};
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    start_.wait(lock,
+                [this, seen] { return !running_ || generation_ != seen; });
+    if (!running_) {
+      return;
+    }
+    seen = generation_;
+    lock.unlock();
+    Drain(worker);
+    lock.lock();
+    if (--busy_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::Drain(std::size_t worker) {
+  Range range;
+  while (Pop(worker, range) || Steal(worker, range)) {
+    try {
+      for (auto index = range.first; index < range.second; ++index) {
+        (*body_)(index, worker);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
+
+bool ThreadPool::Pop(std::size_t worker, Range &range) {
+  auto &queue = *queues_[worker];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.ranges.empty()) {
+    return false;
+  }
+  range = queue.ranges.front();
+  queue.ranges.pop_front();
+  return true;
+}
+
+bool ThreadPool::Steal(std::size_t worker, Range &range) {
+  auto workers = Size();
+  for (std::size_t offset = 1; offset < workers; ++offset) {
+    auto &queue = *queues_[(worker + offset) % workers];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.ranges.empty()) {
+      range = queue.ranges.back();
+      queue.ranges.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
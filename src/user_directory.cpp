@@ -0,0 +1,104 @@
+#include "user_directory.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "linux_parser.h"
+
+UserDirectory::UserDirectory(std::filesystem::path passwd)
+    : passwd_(std::move(passwd)) {
+  Refresh();
+}
+
+UserDirectory &UserDirectory::Instance() {
+  // initialized once in a thread safe way (C++11 magic statics).
+  static UserDirectory directory{LinuxParser::kPasswordPath};
+  return directory;
+}
+
+bool UserDirectory::Refresh() {
+  struct stat info {};
+  if (::stat(passwd_.c_str(), &info) != 0) {
+    return false;
+  }
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (info.st_ino == inode_ && info.st_size == size_ &&
+        info.st_mtim.tv_sec == mtime_.tv_sec &&
+        info.st_mtim.tv_nsec == mtime_.tv_nsec) {
+      return false;
+    }
+  }
+  std::ifstream stream{passwd_};
+  if (!stream.is_open()) {
+    return false;
+  }
+  std::ostringstream content;
+  content << stream.rdbuf();
+  auto users = Parse(content.str());
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  users_ = std::move(users);
+  inode_ = info.st_ino;
+  size_ = info.st_size;
+  mtime_ = info.st_mtim;
+  return true;
+}
+
+std::string UserDirectory::Find(uid_t uid) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto user = std::lower_bound(
+      users_.begin(), users_.end(), uid,
+      [](const User &current, uid_t value) { return current.uid < value; });
+  if (user != users_.end() && user->uid == uid) {
+    return user->name;
+  }
+  return std::to_string(uid);
+}
+
+std::size_t UserDirectory::Size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return users_.size();
+}
+
+std::vector<UserDirectory::User>
+UserDirectory::Parse(std::string_view content) {
+  std::vector<User> users;
+  while (!content.empty()) {
+    auto eol = std::min(content.find('\n'), content.size());
+    auto line = content.substr(0, eol);
+    content.remove_prefix(std::min(eol + 1, content.size()));
+    // name:password:uid:gid:gecos:home:shell
+    auto name_end = line.find(':');
+    if (name_end == std::string_view::npos || name_end == 0) {
+      continue;
+    }
+    auto password_end = line.find(':', name_end + 1);
+    if (password_end == std::string_view::npos) {
+      continue;
+    }
+    auto uid_field = line.substr(password_end + 1);
+    uid_t uid{0};
+    auto end = uid_field.data() + uid_field.size();
+    auto [ptr, ec] = std::from_chars(uid_field.data(), end, uid);
+    if (ec != std::errc() || (ptr != end && *ptr != ':')) {
+      continue;
+    }
+    users.push_back(User{uid, std::string(line.substr(0, name_end))});
+  }
+  // the first entry wins when an uid is repeated, like getpwuid does.
+  std::stable_sort(
+      users.begin(), users.end(),
+      [](const User &a, const User &b) { return a.uid < b.uid; });
+  users.erase(std::unique(users.begin(), users.end(),
+                          [](const User &a, const User &b) {
+                            return a.uid == b.uid;
+                          }),
+              users.end());
+  return users;
+}
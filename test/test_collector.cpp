@@ -0,0 +1,65 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "catch2/catch.hpp"
+#include "collector.h"
+#include "system.h"
+
+TEST_CASE("Should publish a snapshot for each refresh", "[collector]") {
+  System system;
+  Collector collector{system};
+  REQUIRE(nullptr == collector.Latest());
+  collector.Collect();
+  auto first = collector.Latest();
+  REQUIRE(first != nullptr);
+  REQUIRE(1 == first->sequence);
+  REQUIRE(first->processes.Size() > 0);
+  REQUIRE(!first->kernel.empty());
+  // the snapshot held by the renderer is not touched by the next refreshes.
+  for (std::size_t refresh = 0; refresh < 2 * Collector::SNAPSHOTS;
+       ++refresh) {
+    collector.Collect();
+  }
+  auto latest = collector.Latest();
+  REQUIRE(first != latest);
+  REQUIRE(1 == first->sequence);
+  REQUIRE(1 + 2 * Collector::SNAPSHOTS == latest->sequence);
+}
+TEST_CASE("Should fill again the released snapshots", "[collector]") {
+  System system;
+  Collector collector{system};
+  collector.Collect();
+  auto first = collector.Latest();
+  const auto *first_address = first.get();
+  // still the latest: not recycled.
+  collector.Release(collector.Latest());
+  collector.Collect();
+  auto second = collector.Latest();
+  REQUIRE(first_address != second.get());
+  REQUIRE(1 == first->sequence);
+  // the reader is done with it.
+  collector.Release(std::move(first));
+  collector.Collect();
+  auto third = collector.Latest();
+  REQUIRE(first_address == third.get());
+  REQUIRE(3 == third->sequence);
+  // a snapshot never released is left alone.
+  REQUIRE(2 == second->sequence);
+}
+TEST_CASE("Should refresh on its own thread", "[collector]") {
+  System system;
+  Collector collector{system};
+  collector.Start();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (collector.Latest() == nullptr &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  REQUIRE(collector.Latest() != nullptr);
+  collector.RecordRender(std::chrono::milliseconds(1));
+  // stopped without waiting for the refresh interval.
+  auto start = std::chrono::steady_clock::now();
+  collector.Stop();
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
@@ -0,0 +1,41 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "catch2/catch.hpp"
+#include "cpu_monitor.h"
+
+TEST_CASE("Should sample in background", "[cpu_monitor]") {
+  LinuxParser::CPUMonitor monitor{std::chrono::milliseconds(10), 4};
+  REQUIRE(0 == monitor.Samples());
+  REQUIRE(0.0f == monitor.Median());
+  monitor.Start();
+  // keep a cpu busy so the kernel accounts some jiffies.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (monitor.Samples() < 3 && std::chrono::steady_clock::now() < deadline) {
+  }
+  monitor.Stop();
+  auto samples = monitor.Samples();
+  REQUIRE(samples >= 3);
+  REQUIRE(monitor.Median() >= 0.0f);
+  REQUIRE(monitor.Median() <= 100.0f);
+  REQUIRE(monitor.Ema() >= 0.0f);
+  REQUIRE(monitor.Ema() <= 100.0f);
+  auto cores = monitor.CoreUtilization();
+  REQUIRE(static_cast<std::size_t>(sysconf(_SC_NPROCESSORS_ONLN)) ==
+          cores->size());
+  for (auto core : *cores) {
+    REQUIRE(core >= 0.0f);
+    REQUIRE(core <= 100.0f);
+  }
+  // stopped: no more samples.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  REQUIRE(samples == monitor.Samples());
+}
+TEST_CASE("Should not block the caller", "[cpu_monitor]") {
+  auto start = std::chrono::steady_clock::now();
+  LinuxParser::CPUMonitor::Instance().Median();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  REQUIRE(elapsed < std::chrono::milliseconds(100));
+}
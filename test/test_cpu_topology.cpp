@@ -0,0 +1,54 @@
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "catch2/catch.hpp"
+#include "cpu_topology.h"
+
+namespace {
+void WriteAttribute(const std::filesystem::path &path,
+                    const std::string &value) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream out{path};
+  out << value << "\n";
+}
+} // namespace
+
+TEST_CASE("Should parse a cpu list", "[cpu_topology]") {
+  std::vector<unsigned int> expected{0, 1, 2, 3, 8, 10, 11};
+  REQUIRE(expected == CpuTopology::ParseCpuList("0-3,8,10-11"));
+  REQUIRE(CpuTopology::ParseCpuList("").empty());
+}
+TEST_CASE("Should detect sockets, cores and nodes", "[cpu_topology]") {
+  // two sockets, two cores each with two SMT threads, one node per socket.
+  std::filesystem::path root{"/tmp/monitor_sysfs"};
+  auto cpu_root = root / "cpu";
+  auto node_root = root / "node";
+  WriteAttribute(cpu_root / "online", "0-7");
+  for (int id = 0; id < 8; ++id) {
+    auto topology = cpu_root / ("cpu" + std::to_string(id)) / "topology";
+    WriteAttribute(topology / "physical_package_id", std::to_string(id / 4));
+    WriteAttribute(topology / "core_id", std::to_string(id % 2));
+  }
+  WriteAttribute(node_root / "online", "0-1");
+  WriteAttribute(node_root / "node0" / "cpulist", "0-3");
+  WriteAttribute(node_root / "node1" / "cpulist", "4-7");
+
+  auto topology = CpuTopology::Detect(cpu_root, node_root);
+  REQUIRE(8 == topology.OnlineCpus());
+  REQUIRE(2 == topology.Sockets());
+  REQUIRE(4 == topology.Cores());
+  REQUIRE(2 == topology.ThreadsPerCore());
+  REQUIRE(2 == topology.NumaNodes());
+  REQUIRE(1 == topology.Cpus()[5].node);
+  std::filesystem::remove_all(root);
+}
+TEST_CASE("Should share the current topology", "[cpu_topology]") {
+  auto current = CpuTopology::Current();
+  REQUIRE(current == CpuTopology::Current());
+  REQUIRE(sysconf(_SC_NPROCESSORS_ONLN) == current->OnlineCpus());
+  auto refreshed = CpuTopology::Refresh();
+  REQUIRE(refreshed == CpuTopology::Current());
+  REQUIRE(current->OnlineCpus() == refreshed->OnlineCpus());
+}
@@ -0,0 +1,67 @@
+#include "catch2/catch.hpp"
+#include "cpu_usage_tracker.h"
+
+TEST_CASE("Should compute the usage between two refreshes",
+          "[cpu_usage_tracker]") {
+  CpuUsageTracker tracker;
+  // first refresh: no period yet.
+  tracker.BeginTick(10000, 2);
+  REQUIRE(std::nullopt == tracker.Usage(10, 500, 4000));
+  REQUIRE(std::nullopt == tracker.Usage(11, 600, 10));
+  tracker.EndTick();
+  // 200 jiffies over 2 cpus: a period of 100 ticks for each cpu.
+  tracker.BeginTick(10200, 2);
+  auto busy = tracker.Usage(10, 500, 4050);
+  REQUIRE(busy != std::nullopt);
+  REQUIRE(Approx(0.5f) == busy.value());
+  // the pid 11 has been reused by a new process.
+  auto reused = tracker.Usage(11, 9000, 20);
+  REQUIRE(reused != std::nullopt);
+  REQUIRE(Approx(0.2f) == reused.value());
+  tracker.EndTick();
+  REQUIRE(2 == tracker.Size());
+  // the process 10 has exited.
+  tracker.BeginTick(10400, 2);
+  REQUIRE(Approx(0.0f) == tracker.Usage(11, 9000, 20).value());
+  tracker.EndTick();
+  REQUIRE(1 == tracker.Size());
+}
+TEST_CASE("Should keep the usage if nothing has changed",
+          "[cpu_usage_tracker]") {
+  CpuUsageTracker tracker;
+  tracker.BeginTick(100, 1);
+  tracker.Usage(1, 1, 10);
+  tracker.BeginTick(200, 1);
+  REQUIRE(Approx(0.3f) == tracker.Usage(1, 1, 40).value());
+  tracker.BeginTick(200, 1);
+  REQUIRE(Approx(0.3f) == tracker.Usage(1, 1, 40).value());
+}
+TEST_CASE("Should compute the usage of a process sampled less often",
+          "[cpu_usage_tracker]") {
+  CpuUsageTracker tracker;
+  tracker.BeginTick(1000, 1);
+  tracker.Usage(1, 1, 10);
+  tracker.EndTick();
+  tracker.BeginTick(1100, 1);
+  REQUIRE(Approx(0.0f) == tracker.Usage(1, 1, 10).value());
+  tracker.EndTick();
+  // not sampled for two refreshes, but still tracked.
+  tracker.BeginTick(1200, 1);
+  REQUIRE(Approx(0.0f) == tracker.Keep(1, 1).value());
+  REQUIRE(std::nullopt == tracker.Keep(2, 1));
+  tracker.EndTick();
+  tracker.BeginTick(1300, 1);
+  tracker.Keep(1, 1);
+  tracker.EndTick();
+  REQUIRE(1 == tracker.Size());
+  // 60 ticks over the 300 jiffies since the last sample.
+  tracker.BeginTick(1400, 1);
+  REQUIRE(Approx(0.2f) == tracker.Usage(1, 1, 70).value());
+}
+TEST_CASE("Should average the usage since boot", "[cpu_usage_tracker]") {
+  CpuUsageTracker tracker;
+  REQUIRE(0.0f == tracker.Average(100));
+  // 10000 jiffies over 2 cpus: 5000 for each cpu.
+  tracker.BeginTick(10000, 2);
+  REQUIRE(Approx(0.8f) == tracker.Average(4000));
+}
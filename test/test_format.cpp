@@ -17,3 +17,18 @@ TEST_CASE("Shall correctly throw with negative values", "[format]") {
     }
     REQUIRE(true == throwed);
 }
+TEST_CASE("Shall format the memory in megabytes", "[format]") {
+    REQUIRE("0.0" == Format::Megabytes(0));
+    REQUIRE("1.0" == Format::Megabytes(1024 * 1024));
+    // truncated, not rounded.
+    REQUIRE("12.3" == Format::Megabytes(12 * 1024 * 1024 + 399 * 1024));
+}
+TEST_CASE("Shall format in a field", "[format]") {
+    Format::Field field;
+    REQUIRE("100:00:01" == Format::ElapsedTime(360001, field));
+    REQUIRE("00:00:00" == Format::ElapsedTime(-5, field));
+    REQUIRE("12.3" == Format::Megabytes(12 * 1024 * 1024 + 399 * 1024, field));
+    REQUIRE("12.3" == Format::Percent(0.1239f, field));
+    REQUIRE("0.0" == Format::Percent(-1.0f, field));
+    REQUIRE("100.0" == Format::Percent(1.0f, field));
+}
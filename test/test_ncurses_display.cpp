@@ -0,0 +1,164 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "catch2/catch.hpp"
+#include "collector.h"
+#include "ncurses_display.h"
+#include "process_view.h"
+#include "screen_buffer.h"
+#include "system.h"
+
+namespace {
+// allocations of this thread while counting, the other threads (i.e. the
+// cpu monitor) are left alone.
+thread_local bool counting{false};
+thread_local std::size_t allocations{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (counting) {
+    ++allocations;
+  }
+  if (auto memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+TEST_CASE("Shall render a frame without allocating", "[ncurses_display]") {
+  System system;
+  Collector collector{system};
+  collector.Collect();
+  auto snapshot = collector.Latest();
+  REQUIRE(snapshot != nullptr);
+  ProcessView view{40};
+  view.Update(snapshot->processes);
+  REQUIRE(view.Visible() > 0);
+  ScreenBuffer system_buffer{9, 120, 1};
+  ScreenBuffer process_buffer{44, 120, 1};
+  std::size_t cells{0};
+  auto render = [&] {
+    system_buffer.Clear();
+    NCursesDisplay::DisplaySystem(*snapshot, system_buffer);
+    process_buffer.Clear();
+    NCursesDisplay::DisplayProcesses(view, process_buffer, true);
+    auto draw = [](int, int, const char *, int, short) {};
+    cells += system_buffer.Flush(draw) + process_buffer.Flush(draw);
+  };
+  render();
+  auto first = cells;
+  REQUIRE(first > 0);
+  constexpr int FRAMES{1000};
+  counting = true;
+  for (int frame = 0; frame < FRAMES; ++frame) {
+    render();
+  }
+  counting = false;
+  REQUIRE(0 == allocations);
+  // the first frame has drawn everything, the same frames draw nothing.
+  REQUIRE(first == cells);
+}
+TEST_CASE("Shall draw the progress bar", "[ncurses_display]") {
+  Format::Field field;
+  auto bar = NCursesDisplay::ProgressBar(0.5f, field);
+  REQUIRE(62 == bar.size());
+  REQUIRE(" 50.0/100%" == bar.substr(bar.size() - 10));
+  REQUIRE(" 9.4/100%" == NCursesDisplay::ProgressBar(0.094f, field).substr(53));
+  REQUIRE(" 100/100%" == NCursesDisplay::ProgressBar(1.0f, field).substr(53));
+  REQUIRE(NCursesDisplay::ProgressBar(0.25f) ==
+          NCursesDisplay::ProgressBar(0.25f, field));
+}
+TEST_CASE("Shall switch the threads through the collector",
+          "[ncurses_display]") {
+  ProcessView view{10};
+  std::string search;
+  bool searching{true};
+  // typed in the search.
+  REQUIRE(NCursesDisplay::Action::kRedraw ==
+          NCursesDisplay::HandleKey('H', view, search, searching));
+  REQUIRE("H" == search);
+  searching = false;
+  REQUIRE(NCursesDisplay::Action::kToggleThreads ==
+          NCursesDisplay::HandleKey('H', view, search, searching));
+  System system;
+  Collector collector{system};
+  collector.Start();
+  REQUIRE_FALSE(collector.ThreadsMode());
+  // as the display does; the collector thread is a thread of this process.
+  collector.SetThreadsMode(!collector.ThreadsMode());
+  REQUIRE(collector.ThreadsMode());
+  auto threads = [](const Snapshot &snapshot) {
+    for (std::size_t row = 0; row < snapshot.processes.Size(); ++row) {
+      if (snapshot.processes.IsThread(row)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  // refreshed right away, not after the refresh interval.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  auto latest = collector.Latest();
+  while ((latest == nullptr || !threads(*latest)) &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    latest = collector.Latest();
+  }
+  collector.Stop();
+  REQUIRE(latest != nullptr);
+  REQUIRE(threads(*latest));
+  REQUIRE(system.ThreadsMode());
+}
+TEST_CASE("Shall keep the borders through a layout", "[ncurses_display]") {
+  // a terminal of its own, drawing nowhere.
+  auto *output = std::fopen("/dev/null", "w");
+  auto *input = std::fopen("/dev/null", "r");
+  REQUIRE(output != nullptr);
+  REQUIRE(input != nullptr);
+  auto *terminal = newterm("xterm", output, input);
+  if (terminal != nullptr) {
+    NCursesDisplay::Screen screen;
+    screen.system_window = newwin(1, 1, 0, 0);
+    screen.process_window = newwin(1, 1, 0, 0);
+    ProcessView view{0};
+    NCursesDisplay::Layout(screen, view);
+    REQUIRE(screen.fits);
+    REQUIRE(view.Height() > 0);
+    std::string wide(getmaxx(stdscr) * 2, 'x');
+    for (auto *buffer : {&screen.system_buffer, &screen.process_buffer}) {
+      buffer->Clear();
+      buffer->Put(1, 1, wide);
+    }
+    NCursesDisplay::Draw(screen.system_buffer, screen.system_window);
+    NCursesDisplay::Draw(screen.process_buffer, screen.process_window);
+    auto cell = [](WINDOW *window, int row, int column) {
+      return mvwinch(window, row, column) & A_CHARTEXT;
+    };
+    for (auto *window : {screen.system_window, screen.process_window}) {
+      auto last_row = getmaxy(window) - 1;
+      auto last_column = getmaxx(window) - 1;
+      REQUIRE((ACS_ULCORNER & A_CHARTEXT) == cell(window, 0, 0));
+      REQUIRE((ACS_LRCORNER & A_CHARTEXT) ==
+              cell(window, last_row, last_column));
+      REQUIRE((ACS_VLINE & A_CHARTEXT) == cell(window, 1, 0));
+      REQUIRE((ACS_VLINE & A_CHARTEXT) == cell(window, 1, last_column));
+      REQUIRE('x' == cell(window, 1, last_column - 1));
+      REQUIRE((ACS_HLINE & A_CHARTEXT) == cell(window, last_row, 1));
+    }
+    delwin(screen.process_window);
+    delwin(screen.system_window);
+    endwin();
+    delscreen(terminal);
+  } else {
+    WARN("no terminfo for xterm, the layout is not checked");
+  }
+  std::fclose(input);
+  std::fclose(output);
+}
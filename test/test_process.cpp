@@ -1,7 +1,11 @@
+#include <unistd.h>
+
 #include <fstream>
 
 #include "catch2/catch.hpp"
+#include "cpu_usage_tracker.h"
 #include "process.h"
+#include "procfs.h"
 #include "util.h"
 
 TEST_CASE("Should find current user", "[process]") {
@@ -12,7 +16,9 @@ TEST_CASE("Should find current user", "[process]") {
 TEST_CASE("Should find current ram", "[process]") {
   std::filesystem::path initprocess{"/proc/1"};
   auto process = ProcessBuilder::Build(initprocess);
-  REQUIRE(process.Ram().size() > 0);
+  REQUIRE(process.Vsz() > 0);
+  REQUIRE(process.Vsz() >= process.Rss());
+  REQUIRE(process.Rss() >= process.Shared());
 }
 
 TEST_CASE("Should not found user", "[process]") {
@@ -45,3 +51,66 @@ TEST_CASE("Should create the same number of processes", "[process]") {
   }
   REQUIRE(list_processes.size() == actual_pids.size());
 }
+TEST_CASE("Should update a process without building it again", "[process]") {
+  std::filesystem::path self{"/proc"};
+  self /= std::to_string(getpid());
+  auto process = ProcessBuilder::Build(self);
+  REQUIRE(ProcessBuilder::Update(process));
+  REQUIRE(getpid() == process.Pid());
+  REQUIRE(process.Rss() > 0);
+  REQUIRE(process.Command().size() > 0);
+}
+TEST_CASE("Should report the processes that cannot be built", "[process]") {
+  auto self = ProcessBuilder::TryBuild(getpid());
+  REQUIRE(self.has_value());
+  REQUIRE(getpid() == self->Pid());
+  auto invalid = ProcessBuilder::TryBuild(-1);
+  REQUIRE(!invalid);
+  REQUIRE(ProcessError::kInvalidPid == invalid.error());
+  // above the highest pid that the kernel can assign.
+  auto missing = ProcessBuilder::TryBuild(1 << 23);
+  REQUIRE(!missing);
+  REQUIRE(ProcessError::kNotFound == missing.error());
+  REQUIRE_THROWS_AS(ProcessBuilder::Build("/proc/8388608"), std::runtime_error);
+}
+TEST_CASE("Should sample a skipped process that is not tracked", "[process]") {
+  auto self = ProcessBuilder::TryBuild(getpid());
+  REQUIRE(self.has_value());
+  CpuUsageTracker tracker;
+  tracker.BeginTick(10000, 1);
+  // nothing to keep: the process gets a sample of its own.
+  ProcessBuilder::Skip(*self);
+  ProcessBuilder::UpdateCpuUsage(*self, tracker);
+  REQUIRE(1 == tracker.Size());
+  tracker.EndTick();
+  tracker.BeginTick(10100, 1);
+  ProcessBuilder::Skip(*self);
+  ProcessBuilder::UpdateCpuUsage(*self, tracker);
+  tracker.EndTick();
+  // kept across the refresh.
+  REQUIRE(1 == tracker.Size());
+}
+TEST_CASE("Should sample the threads of a skipped process", "[process]") {
+  auto self = ProcessBuilder::TryBuild(getpid());
+  REQUIRE(self.has_value());
+  // the same ticks twice: idle for a refresh.
+  CpuUsageTracker tracker;
+  for (auto total : {10000ULL, 10100ULL}) {
+    tracker.BeginTick(total, 1);
+    ProcessBuilder::UpdateCpuUsage(*self, tracker);
+    tracker.EndTick();
+  }
+  REQUIRE(1 == self->IdleRefreshes());
+  ProcessBuilder::Skip(*self);
+  auto tids = LinuxParser::ProcFs::Tids(getpid());
+  REQUIRE(!tids.empty());
+  StringPool::Cache strings{StringPool::Shared()};
+  auto thread = ProcessBuilder::TryBuildThread(*self, tids.front(), strings);
+  REQUIRE(thread.has_value());
+  REQUIRE(0 == thread->IdleRefreshes());
+  // the thread is sampled, not kept like its process.
+  CpuUsageTracker thread_tracker;
+  thread_tracker.BeginTick(10000, 1);
+  ProcessBuilder::UpdateCpuUsage(*thread, thread_tracker);
+  REQUIRE(1 == thread_tracker.Size());
+}
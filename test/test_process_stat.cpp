@@ -0,0 +1,36 @@
+#include <unistd.h>
+
+#include "catch2/catch.hpp"
+#include "process_stat.h"
+
+TEST_CASE("Should parse a stat record with a tricky comm", "[process_stat]") {
+  std::string record{
+      "4242 (my (odd) proc) S 1 4242 4242 0 -1 4194560 1000 20 3 0 150 75 2 1 "
+      "20 0 4 0 123456 10485760 2560 18446744073709551615 1 1 0 0 0 0 0 4096 "
+      "16384 0 0 0 17 3 0 0 7 0 0 0 0 0 0 0 0 0\n"};
+  auto stat = LinuxParser::ParseProcessStat(record);
+  REQUIRE(stat != std::nullopt);
+  REQUIRE(4242 == stat->pid);
+  REQUIRE("my (odd) proc" == stat->Comm());
+  REQUIRE('S' == stat->state);
+  REQUIRE(1 == stat->ppid);
+  REQUIRE(-1 == stat->tpgid);
+  REQUIRE(150 == stat->utime);
+  REQUIRE(75 == stat->stime);
+  REQUIRE(4 == stat->num_threads);
+  REQUIRE(123456 == stat->starttime);
+  REQUIRE(2560 == stat->rss);
+  REQUIRE(3 == stat->processor);
+  REQUIRE(7 == stat->delayacct_blkio_ticks);
+}
+TEST_CASE("Should refuse a truncated stat record", "[process_stat]") {
+  REQUIRE(std::nullopt == LinuxParser::ParseProcessStat("12 (bash) S 1 2 3"));
+  REQUIRE(std::nullopt == LinuxParser::ParseProcessStat("12 bash S 1 2 3"));
+}
+TEST_CASE("Should read the stat of the current process", "[process_stat]") {
+  auto stat = LinuxParser::ReadProcessStat("/proc/self");
+  REQUIRE(stat != std::nullopt);
+  REQUIRE(getpid() == stat->pid);
+  REQUIRE(getppid() == stat->ppid);
+  REQUIRE(stat->Comm().size() > 0);
+}
@@ -0,0 +1,26 @@
+#include <unistd.h>
+
+#include "catch2/catch.hpp"
+#include "process_statm.h"
+
+TEST_CASE("Should parse a statm line", "[process_statm]") {
+  auto statm = LinuxParser::ParseProcessStatm("2601 1344 938 209 0 289 0\n");
+  REQUIRE(statm != std::nullopt);
+  REQUIRE(2601 == statm->size);
+  REQUIRE(1344 == statm->resident);
+  REQUIRE(938 == statm->shared);
+  REQUIRE(209 == statm->text);
+  REQUIRE(289 == statm->data);
+}
+TEST_CASE("Should refuse a truncated statm line", "[process_statm]") {
+  REQUIRE(std::nullopt == LinuxParser::ParseProcessStatm("2601 1344 938"));
+  REQUIRE(std::nullopt == LinuxParser::ParseProcessStatm("2601 x 1 1 1 1 1"));
+  REQUIRE(std::nullopt == LinuxParser::ParseProcessStatm(""));
+}
+TEST_CASE("Should read the statm of the current process", "[process_statm]") {
+  auto statm = LinuxParser::ReadProcessStatm(getpid());
+  REQUIRE(statm != std::nullopt);
+  REQUIRE(statm->size > 0);
+  REQUIRE(statm->resident > 0);
+  REQUIRE(statm->size >= statm->resident);
+}
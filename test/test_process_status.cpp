@@ -0,0 +1,50 @@
+#include <unistd.h>
+
+#include "catch2/catch.hpp"
+#include "process_status.h"
+
+TEST_CASE("Should parse the status fields in one pass", "[process_status]") {
+  std::string content{"Name:\tpostgres\n"
+                      "Umask:\t0077\n"
+                      "State:\tS (sleeping)\n"
+                      "Tgid:\t812\n"
+                      "Pid:\t812\n"
+                      "PPid:\t1\n"
+                      "Uid:\t105\t106\t107\t108\n"
+                      "Gid:\t113\t113\t113\t113\n"
+                      "VmPeak:\t  221024 kB\n"
+                      "VmSize:\t  219880 kB\n"
+                      "VmRSS:\t   28432 kB\n"
+                      "VmSwap:\t       12 kB\n"
+                      "Threads:\t1\n"
+                      "voluntary_ctxt_switches:\t5301\n"
+                      "nonvoluntary_ctxt_switches:\t27\n"};
+  auto status = LinuxParser::ParseProcessStatus(content);
+  REQUIRE(status != std::nullopt);
+  REQUIRE("postgres" == status->Name());
+  REQUIRE('S' == status->state);
+  REQUIRE(812 == status->tgid);
+  REQUIRE(1 == status->ppid);
+  REQUIRE(105 == status->uid[0]);
+  REQUIRE(108 == status->uid[3]);
+  REQUIRE(113 == status->gid[1]);
+  REQUIRE(221024 == status->vm_peak);
+  REQUIRE(219880 == status->vm_size);
+  REQUIRE(28432 == status->vm_rss);
+  REQUIRE(12 == status->vm_swap);
+  REQUIRE(1 == status->threads);
+  REQUIRE(5301 == status->voluntary_ctxt_switches);
+  REQUIRE(27 == status->nonvoluntary_ctxt_switches);
+}
+TEST_CASE("Should refuse a status without uid", "[process_status]") {
+  REQUIRE(std::nullopt == LinuxParser::ParseProcessStatus("Name:\tbash\n"));
+}
+TEST_CASE("Should read the status of the current process",
+          "[process_status]") {
+  auto status = LinuxParser::ReadProcessStatus("/proc/self");
+  REQUIRE(status != std::nullopt);
+  REQUIRE(getpid() == status->pid);
+  REQUIRE(getuid() == status->uid[0]);
+  REQUIRE(status->vm_size > 0);
+  REQUIRE(status->threads >= 1);
+}
@@ -0,0 +1,94 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "catch2/catch.hpp"
+#include "process_table.h"
+#include "procfs.h"
+#include "string_arena.h"
+
+TEST_CASE("Should store equal strings once", "[process_table]") {
+  StringArena arena;
+  std::string root{"root"};
+  auto first = arena.Intern(root);
+  root[0] = 'b';
+  auto second = arena.Intern("root");
+  REQUIRE("root" == first);
+  REQUIRE(first.data() == second.data());
+  REQUIRE(1 == arena.Size());
+  // longer than a block.
+  std::string huge(StringArena::BLOCK_SIZE * 2, 'x');
+  REQUIRE(huge == arena.Intern(huge));
+  REQUIRE("root" == first);
+  arena.Clear();
+  REQUIRE(0 == arena.Size());
+  REQUIRE("daemon" == arena.Intern("daemon"));
+}
+TEST_CASE("Should fill the columns of the processes", "[process_table]") {
+  auto self = ProcessBuilder::TryBuild(getpid());
+  REQUIRE(self.has_value());
+  ProcessTable table;
+  table.Append(*self);
+  table.Append(*self);
+  REQUIRE(2 == table.Size());
+  REQUIRE(getpid() == table.Pid(1));
+  REQUIRE(self->User() == table.User(1));
+  REQUIRE(self->Command() == table.Command(0));
+  REQUIRE(self->Vsz() == table.Vsz(0));
+  REQUIRE(self->Rss() == table.Rss(1));
+  REQUIRE(table.Command(0).data() == table.Command(1).data());
+  REQUIRE(2 == table.Pids().size());
+  table.Clear();
+  REQUIRE(0 == table.Size());
+}
+TEST_CASE("Should order the top processes", "[process_table]") {
+  ProcessTable table;
+  for (auto pid : LinuxParser::ProcFs::Pids()) {
+    auto process = ProcessBuilder::TryBuild(pid);
+    if (process) {
+      table.Append(*process);
+    }
+  }
+  REQUIRE(table.Size() > 2);
+  table.Sort(SortKey::kTime, true, 2);
+  const auto &order = table.Order();
+  REQUIRE(table.Size() == order.size());
+  // the first two are the largest, in order.
+  REQUIRE(table.UpTime(order[0]) >= table.UpTime(order[1]));
+  for (std::size_t row = 2; row < order.size(); ++row) {
+    REQUIRE(table.UpTime(order[1]) >= table.UpTime(order[row]));
+  }
+  table.Sort(SortKey::kPid, true, table.Size());
+  REQUIRE(std::is_sorted(order.rbegin(), order.rend()));
+  table.Sort(SortKey::kCommand, false, table.Size());
+  for (std::size_t row = 1; row < order.size(); ++row) {
+    REQUIRE(table.Command(order[row - 1]) <= table.Command(order[row]));
+  }
+  table.Sort(SortKey::kPid, false, 0);
+  REQUIRE(std::is_sorted(order.begin(), order.end()));
+}
+TEST_CASE("Should copy a table with its own strings", "[process_table]") {
+  auto self = ProcessBuilder::TryBuild(getpid());
+  REQUIRE(self.has_value());
+  auto copy = std::make_unique<ProcessTable>();
+  {
+    ProcessTable table;
+    table.Append(*self);
+    table.Append(*self);
+    table.Sort(SortKey::kPid, true, 2);
+    // the same handles, stored once.
+    REQUIRE(table.Command(0).data() == table.Command(1).data());
+    copy->Assign(table);
+    REQUIRE(table.Command(0).data() != copy->Command(0).data());
+  }
+  // the source is gone, the strings of the copy are still there.
+  REQUIRE(2 == copy->Size());
+  REQUIRE(self->Command() == copy->Command(1));
+  REQUIRE(self->User() == copy->User(0));
+  REQUIRE(getpid() == copy->Pid(1));
+  REQUIRE(2 == copy->Order().size());
+  copy->Assign(*copy);
+  REQUIRE(self->Command() == copy->Command(0));
+}
@@ -0,0 +1,94 @@
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "catch2/catch.hpp"
+#include "process_table.h"
+#include "process_view.h"
+#include "procfs.h"
+
+namespace {
+void FillTable(ProcessTable &table) {
+  for (auto pid : LinuxParser::ProcFs::Pids()) {
+    auto process = ProcessBuilder::TryBuild(pid);
+    if (process) {
+      table.Append(*process);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Should order the rows of the view", "[process_view]") {
+  ProcessTable table;
+  FillTable(table);
+  REQUIRE(table.Size() > 2);
+  ProcessView view{2};
+  view.Update(table);
+  REQUIRE(SortKey::kCpu == view.Key());
+  REQUIRE(view.Descending());
+  REQUIRE(2 == view.Visible());
+  REQUIRE(table.Size() == view.Size());
+  view.SortBy(SortKey::kPid);
+  REQUIRE(!view.Descending());
+  REQUIRE(view.Table().Pid(view.Row(0)) < view.Table().Pid(view.Row(1)));
+  // the same column again reverses the order.
+  view.SortBy(SortKey::kPid);
+  REQUIRE(view.Descending());
+  REQUIRE(view.Table().Pid(view.Row(0)) > view.Table().Pid(view.Row(1)));
+}
+TEST_CASE("Should scroll through all the rows", "[process_view]") {
+  ProcessTable table;
+  FillTable(table);
+  ProcessView view{2};
+  view.Update(table);
+  view.SortBy(SortKey::kPid);
+  view.ScrollBy(-5);
+  REQUIRE(0 == view.Offset());
+  view.ScrollTo(view.Size());
+  // the last rows stay on the screen, ordered too.
+  REQUIRE(view.Size() - 2 == view.Offset());
+  REQUIRE(2 == view.Visible());
+  REQUIRE(view.Table().Pid(view.Row(0)) < view.Table().Pid(view.Row(1)));
+  REQUIRE(*std::max_element(table.Pids().begin(), table.Pids().end()) ==
+          view.Table().Pid(view.Row(1)));
+  view.ScrollBy(-1);
+  REQUIRE(view.Size() - 3 == view.Offset());
+}
+TEST_CASE("Should show only the rows matching the search", "[process_view]") {
+  ProcessTable table;
+  FillTable(table);
+  ProcessView view{100};
+  view.Update(table);
+  auto self = ProcessBuilder::TryBuild(getpid());
+  REQUIRE(self.has_value());
+  std::string command{self->Command()};
+  view.Search(command);
+  REQUIRE(view.Size() >= 1);
+  for (std::size_t line = 0; line < view.Visible(); ++line) {
+    REQUIRE(view.Table().Command(view.Row(line)).find(command) !=
+            std::string_view::npos);
+  }
+  view.Search("no process has such a command");
+  REQUIRE(0 == view.Size());
+  REQUIRE(0 == view.Visible());
+  view.Search("");
+  REQUIRE(table.Size() == view.Size());
+}
+TEST_CASE("Should follow the height of the screen", "[process_view]") {
+  ProcessTable table;
+  FillTable(table);
+  REQUIRE(table.Size() > 3);
+  ProcessView view{1};
+  view.Update(table);
+  view.ScrollTo(table.Size());
+  REQUIRE(table.Size() - 1 == view.Offset());
+  // taller: the rows above come down, the last one stays at the bottom.
+  view.SetHeight(3);
+  REQUIRE(table.Size() - 3 == view.Offset());
+  REQUIRE(3 == view.Visible());
+  view.SetHeight(table.Size() + 10);
+  REQUIRE(0 == view.Offset());
+  REQUIRE(table.Size() == view.Visible());
+  view.SetHeight(0);
+  REQUIRE(0 == view.Visible());
+}
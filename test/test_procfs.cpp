@@ -0,0 +1,50 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "catch2/catch.hpp"
+#include "procfs.h"
+
+TEST_CASE("Should read a whole file of /proc", "[procfs]") {
+  auto content = LinuxParser::ProcFs::Read(AT_FDCWD, "/proc/self/stat");
+  REQUIRE(content != std::nullopt);
+  REQUIRE(std::to_string(getpid()) == content->substr(0, content->find(' ')));
+  auto meminfo = LinuxParser::ProcFs::Read("meminfo");
+  REQUIRE(meminfo != std::nullopt);
+  // larger than a single page on most systems, the buffer has to grow.
+  REQUIRE(meminfo->find("MemTotal:") == 0);
+}
+TEST_CASE("Should read the files of a process", "[procfs]") {
+  auto status = LinuxParser::ProcFs::ReadPid(getpid(), "status");
+  REQUIRE(status != std::nullopt);
+  REQUIRE(status->find("Name:") == 0);
+  REQUIRE(LinuxParser::ProcFs::CachedPids() > 0);
+  REQUIRE(std::nullopt == LinuxParser::ProcFs::ReadPid(-1, "status"));
+  REQUIRE(std::nullopt == LinuxParser::ProcFs::ReadPid(getpid(), "missing"));
+}
+TEST_CASE("Should close the directories of exited processes", "[procfs]") {
+  REQUIRE(LinuxParser::ProcFs::ReadPid(getpid(), "stat") != std::nullopt);
+  LinuxParser::ProcFs::RetainPids({});
+  REQUIRE(0 == LinuxParser::ProcFs::CachedPids());
+  // a dropped directory is opened again on the next read.
+  REQUIRE(LinuxParser::ProcFs::ReadPid(getpid(), "stat") != std::nullopt);
+  REQUIRE(1 == LinuxParser::ProcFs::CachedPids());
+}
+TEST_CASE("Should list the pids in /proc", "[procfs]") {
+  auto pids = LinuxParser::ProcFs::Pids();
+  REQUIRE(!pids.empty());
+  REQUIRE(std::is_sorted(pids.begin(), pids.end()));
+  REQUIRE(std::binary_search(pids.begin(), pids.end(), getpid()));
+  REQUIRE(std::binary_search(pids.begin(), pids.end(), 1));
+  // a second listing starts again from the beginning of /proc.
+  auto again = LinuxParser::ProcFs::Pids();
+  REQUIRE(std::binary_search(again.begin(), again.end(), getpid()));
+}
+TEST_CASE("Should list the threads of a process", "[procfs]") {
+  auto tids = LinuxParser::ProcFs::Tids(getpid());
+  REQUIRE(!tids.empty());
+  REQUIRE(std::binary_search(tids.begin(), tids.end(), getpid()));
+  REQUIRE(LinuxParser::ProcFs::Tids(-1).empty());
+}
@@ -0,0 +1,52 @@
+#include <chrono>
+
+#include "catch2/catch.hpp"
+#include "refresh_scheduler.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Should average the cost of the phases", "[refresh_scheduler]") {
+  RefreshScheduler scheduler;
+  REQUIRE(0ns == scheduler.FrameCost());
+  scheduler.Record(RefreshPhase::kProcesses, 10ms);
+  REQUIRE(10ms == scheduler.Cost(RefreshPhase::kProcesses));
+  scheduler.Record(RefreshPhase::kProcesses, 20ms);
+  REQUIRE(Approx(13e6) == scheduler.Cost(RefreshPhase::kProcesses).count());
+  scheduler.Record(RefreshPhase::kRender, 2ms);
+  REQUIRE(Approx(15e6) == scheduler.FrameCost().count());
+}
+TEST_CASE("Should keep the interval within the cpu share",
+          "[refresh_scheduler]") {
+  RefreshScheduler scheduler{{50ms, 0.01, 1000ms, 10000ms}};
+  REQUIRE(1000ms == scheduler.Interval());
+  // 30ms every 3s is 1% of a cpu.
+  scheduler.Record(RefreshPhase::kSystem, 30ms);
+  REQUIRE(3000ms == scheduler.Interval());
+  scheduler.Record(RefreshPhase::kSystem, 500ms);
+  REQUIRE(10000ms == scheduler.Interval());
+}
+TEST_CASE("Should stretch the strides over budget", "[refresh_scheduler]") {
+  RefreshScheduler scheduler{{10ms, 0.01, 1000ms, 10000ms}};
+  REQUIRE(scheduler.SlowDataDue());
+  REQUIRE(scheduler.SampleDue(7));
+  scheduler.Record(RefreshPhase::kProcesses, 20ms);
+  scheduler.EndRefresh();
+  // the idle processes are sampled every other refresh, spread by pid.
+  REQUIRE(2 == scheduler.IdleStride());
+  REQUIRE(scheduler.SampleDue(7) != scheduler.SampleDue(8));
+  REQUIRE(!scheduler.SlowDataDue());
+  while (scheduler.IdleStride() < RefreshScheduler::MAX_STRIDE) {
+    scheduler.EndRefresh();
+  }
+  REQUIRE(RefreshScheduler::SLOW_DATA_STRIDE == scheduler.SlowDataStride());
+  // then the slow data.
+  scheduler.EndRefresh();
+  REQUIRE(2 * RefreshScheduler::SLOW_DATA_STRIDE == scheduler.SlowDataStride());
+  // well under budget: back to the defaults.
+  for (int refresh = 0; refresh < 20; ++refresh) {
+    scheduler.Record(RefreshPhase::kProcesses, 0ms);
+    scheduler.EndRefresh();
+  }
+  REQUIRE(RefreshScheduler::SLOW_DATA_STRIDE == scheduler.SlowDataStride());
+  REQUIRE(1 == scheduler.IdleStride());
+}
@@ -0,0 +1,85 @@
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "screen_buffer.h"
+
+namespace {
+using Run = std::tuple<int, int, std::string, short>;
+
+std::vector<Run> Flush(ScreenBuffer &buffer) {
+  std::vector<Run> runs;
+  buffer.Flush([&runs](int row, int column, const char *text, int length,
+                       short color) {
+    runs.emplace_back(row, column, std::string(text, length), color);
+  });
+  return runs;
+}
+} // namespace
+
+TEST_CASE("Should draw only the changed cells", "[screen_buffer]") {
+  ScreenBuffer buffer{3, 10};
+  // a new window is blank, there is nothing to draw.
+  REQUIRE(Flush(buffer).empty());
+  buffer.Put(1, 2, "hello");
+  REQUIRE(std::vector<Run>{{1, 2, "hello", 0}} == Flush(buffer));
+  // the same frame again.
+  buffer.Clear();
+  buffer.Put(1, 2, "hello");
+  REQUIRE(Flush(buffer).empty());
+  // one letter changed and a colored cell added.
+  buffer.Clear();
+  buffer.Put(1, 2, "hullo");
+  buffer.Put(2, 0, "x", -1, 3);
+  REQUIRE(std::vector<Run>{{1, 3, "u", 0}, {2, 0, "x", 3}} == Flush(buffer));
+  // what is not written anymore is blanked.
+  buffer.Clear();
+  REQUIRE(std::vector<Run>{{1, 2, "     ", 0}, {2, 0, " ", 0}} ==
+          Flush(buffer));
+}
+TEST_CASE("Should clip and pad the text", "[screen_buffer]") {
+  ScreenBuffer buffer{2, 6};
+  buffer.Put(0, 0, "abc", 5);
+  buffer.Put(0, 0, "xy", 1);
+  buffer.Put(1, 4, "long\ntext");
+  buffer.Put(5, 0, "outside");
+  REQUIRE(std::vector<Run>{{0, 0, "xbc", 0}, {1, 4, "lo", 0}} ==
+          Flush(buffer));
+  buffer.Clear();
+  // a control character would move the cursor.
+  buffer.Put(0, 0, "a\tc");
+  REQUIRE(std::vector<Run>{{0, 0, "a ", 0}, {1, 4, "  ", 0}} == Flush(buffer));
+}
+TEST_CASE("Should draw everything after a resize", "[screen_buffer]") {
+  ScreenBuffer buffer{1, 4};
+  buffer.Put(0, 0, "ab");
+  Flush(buffer);
+  buffer.Invalidate();
+  buffer.Put(0, 0, "ab");
+  REQUIRE(std::vector<Run>{{0, 0, "ab  ", 0}} == Flush(buffer));
+  buffer.Resize(2, 3);
+  REQUIRE(2 == buffer.Rows());
+  REQUIRE(3 == buffer.Columns());
+  REQUIRE(std::vector<Run>{{0, 0, "   ", 0}, {1, 0, "   ", 0}} ==
+          Flush(buffer));
+}
+TEST_CASE("Should never write the border", "[screen_buffer]") {
+  ScreenBuffer buffer{4, 8, 1};
+  REQUIRE(1 == buffer.Border());
+  buffer.Put(1, 1, "too long for the window");
+  buffer.Put(0, 1, "top");
+  buffer.Put(3, 1, "bottom");
+  buffer.Put(2, 0, "left");
+  buffer.Put(2, 7, "right");
+  // the blank is already on the screen.
+  REQUIRE(std::vector<Run>{{1, 1, "too", 0}, {1, 5, "lo", 0}} ==
+          Flush(buffer));
+}
+
+TEST_CASE("Should not draw the border after a resize", "[screen_buffer]") {
+  ScreenBuffer buffer{3, 4, 1};
+  buffer.Resize(3, 5);
+  // only the inside is drawn again, the box of the window stays.
+  REQUIRE(std::vector<Run>{{1, 1, "   ", 0}} == Flush(buffer));
+}
@@ -0,0 +1,78 @@
+#include <string>
+
+#include "catch2/catch.hpp"
+#include "string_pool.h"
+
+TEST_CASE("Should intern equal strings once", "[string_pool]") {
+  StringPool pool;
+  std::string user{"root"};
+  auto first = pool.Intern(user);
+  user[0] = 'b';
+  auto second = pool.Intern("root");
+  REQUIRE(first == second);
+  REQUIRE(first.View().data() == second.View().data());
+  REQUIRE(pool.Intern("daemon") != first);
+  REQUIRE(2 == pool.Size());
+  REQUIRE(StringPool::Handle{}.View().empty());
+}
+TEST_CASE("Should collect the strings not in use", "[string_pool]") {
+  StringPool pool;
+  auto kept = pool.Intern("kept");
+  pool.Intern("dropped");
+  pool.NextGeneration();
+  pool.Mark(kept);
+  pool.Sweep();
+  REQUIRE(1 == pool.Size());
+  REQUIRE("kept" == kept.View());
+  // many dead strings make the pool compact, the handles stay valid.
+  for (std::size_t round = 0; round < 4; ++round) {
+    for (std::size_t i = 0; i < StringPool::MIN_GARBAGE; ++i) {
+      pool.Intern("worker " + std::to_string(round) + "/" +
+                  std::to_string(i));
+    }
+    pool.NextGeneration();
+    pool.Mark(kept);
+    pool.Sweep();
+    REQUIRE(1 == pool.Size());
+    REQUIRE("kept" == kept.View());
+  }
+  REQUIRE(kept == pool.Intern("kept"));
+}
+TEST_CASE("Should keep an empty string apart", "[string_pool]") {
+  StringPool pool;
+  // i.e. the comm of a thread cleared by prctl.
+  auto empty = pool.Intern("");
+  auto root = pool.Intern("root");
+  REQUIRE(empty != root);
+  REQUIRE(empty == pool.Intern(""));
+  REQUIRE(2 == pool.Size());
+  // compacted with both alive.
+  for (std::size_t i = 0; i < 2 * StringPool::MIN_GARBAGE; ++i) {
+    pool.Intern("worker " + std::to_string(i));
+  }
+  pool.NextGeneration();
+  pool.Mark(empty);
+  pool.Mark(root);
+  pool.Sweep();
+  REQUIRE(2 == pool.Size());
+  REQUIRE(empty.View().empty());
+  REQUIRE("root" == root.View());
+  REQUIRE(empty == pool.Intern(""));
+  REQUIRE(root == pool.Intern("root"));
+}
+TEST_CASE("Should intern through a cache", "[string_pool]") {
+  StringPool pool;
+  StringPool::Cache cache{pool};
+  auto root = cache.Intern("root");
+  REQUIRE(root == cache.Intern("root"));
+  REQUIRE(root == pool.Intern("root"));
+  REQUIRE(cache.Intern("") != root);
+  // forgotten by the sweep, the cache doesn't hand it out again.
+  pool.NextGeneration();
+  pool.Sweep();
+  REQUIRE(0 == pool.Size());
+  auto again = cache.Intern("root");
+  REQUIRE("root" == again.View());
+  REQUIRE(1 == pool.Size());
+  REQUIRE(again == pool.Intern("root"));
+}
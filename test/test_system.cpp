@@ -1,6 +1,8 @@
 #include "catch2/catch.hpp"
 #include "system.h"
 #include <fstream>
+#include <algorithm>
+#include <unistd.h>
 
 TEST_CASE("Shall be the kernel version correct", "[system]") {
     System currentSystem;
@@ -38,3 +40,47 @@ TEST_CASE("Shall be the Ubuntu version correct", "[system]") {
     System system;
     REQUIRE("Ubuntu 20.04.3 LTS" == system.OperatingSystem());
 }
+TEST_CASE("Shall be the processes refreshed incrementally", "[system]") {
+    System system;
+    auto first = system.Processes();
+    REQUIRE(first.size() > 0);
+    system.Refresh();
+    auto &second = system.Processes();
+    REQUIRE(second.size() > 0);
+    REQUIRE(std::is_sorted(second.begin(), second.end()));
+    auto self = std::find_if(
+        second.begin(), second.end(),
+        [](const Process &p) { return p.Pid() == getpid(); });
+    REQUIRE(self != second.end());
+    REQUIRE(self->Command().size() > 0);
+}
+TEST_CASE("Shall be the refresh counted", "[system]") {
+    System system;
+    auto &processes = system.Processes();
+    auto stats = system.LastRefreshStats();
+    REQUIRE(processes.size() == stats.built + stats.updated);
+    system.Refresh();
+    system.Processes();
+    REQUIRE(system.LastRefreshStats().updated > 0);
+}
+TEST_CASE("Shall be the threads under their process", "[system]") {
+    System system;
+    system.SetThreadsMode(true);
+    system.Processes();
+    REQUIRE(system.LastRefreshStats().threads > 0);
+    const auto &table = system.Table();
+    const auto &order = table.Order();
+    auto self = std::find_if(order.begin(), order.end(), [&](auto row) {
+        return !table.IsThread(row) && table.Pid(row) == getpid();
+    });
+    REQUIRE(self != order.end());
+    // the monitor has background threads, the first one is the main thread.
+    REQUIRE(self + 2 < order.end());
+    REQUIRE(table.IsThread(*(self + 1)));
+    REQUIRE(getpid() == table.Pid(*(self + 1)));
+    REQUIRE(table.IsThread(*(self + 2)));
+    system.SetThreadsMode(false);
+    system.Refresh();
+    system.Processes();
+    REQUIRE(0 == system.LastRefreshStats().threads);
+}
@@ -0,0 +1,80 @@
+#include <unistd.h>
+
+#include "catch2/catch.hpp"
+#include "system_stat.h"
+
+TEST_CASE("Should parse all the /proc/stat lines", "[system_stat]") {
+  std::string content{
+      "cpu  300 10 200 5000 40 5 6 7 2 1\n"
+      "cpu0 150 5 100 2500 20 3 3 4 1 0\n"
+      "cpu1 150 5 100 2500 20 2 3 3 1 1\n"
+      "intr 123456 10 0 0 27\n"
+      "ctxt 998877\n"
+      "btime 1690000000\n"
+      "processes 4242\n"
+      "procs_running 3\n"
+      "procs_blocked 1\n"
+      "softirq 5555 1 2 3 4 5 6 7 8 9 10\n"};
+  auto snapshot = LinuxParser::ParseSystemStat(content);
+  REQUIRE(snapshot != std::nullopt);
+  REQUIRE(300 == snapshot->cpu.user);
+  REQUIRE(1 == snapshot->cpu.guest_nice);
+  REQUIRE(5568 == snapshot->cpu.Total());
+  REQUIRE(5040 == snapshot->cpu.IdleAll());
+  REQUIRE(2 == snapshot->cores.Size());
+  REQUIRE(1 == snapshot->cores.id[1]);
+  REQUIRE(2 == snapshot->cores.irq[1]);
+  REQUIRE(123456 == snapshot->intr);
+  REQUIRE(998877 == snapshot->ctxt);
+  REQUIRE(1690000000 == snapshot->btime);
+  REQUIRE(4242 == snapshot->processes);
+  REQUIRE(3 == snapshot->procs_running);
+  REQUIRE(1 == snapshot->procs_blocked);
+  REQUIRE(5555 == snapshot->softirq);
+}
+TEST_CASE("Should refuse a /proc/stat without cpu", "[system_stat]") {
+  REQUIRE(std::nullopt == LinuxParser::ParseSystemStat("ctxt 10\n"));
+}
+TEST_CASE("Should read the current /proc/stat", "[system_stat]") {
+  auto snapshot = LinuxParser::ReadSystemStat();
+  REQUIRE(snapshot != std::nullopt);
+  REQUIRE(snapshot->cpu.Total() > 0);
+  REQUIRE(static_cast<std::size_t>(sysconf(_SC_NPROCESSORS_ONLN)) ==
+          snapshot->cores.Size());
+  REQUIRE(snapshot->procs_running >= 1);
+}
+TEST_CASE("Should compute the utilization of each core", "[system_stat]") {
+  auto previous = LinuxParser::ParseSystemStat("cpu  0 0 0 0 0 0 0 0\n"
+                                               "cpu0 100 0 100 800 0 0 0 0\n"
+                                               "cpu1 100 0 100 800 0 0 0 0\n");
+  auto current = LinuxParser::ParseSystemStat("cpu  0 0 0 0 0 0 0 0\n"
+                                              "cpu0 175 0 100 825 0 0 0 0\n"
+                                              "cpu1 100 0 100 900 0 0 0 0\n");
+  std::vector<float> utilization;
+  LinuxParser::CoreUtilization(previous->cores, current->cores, utilization);
+  REQUIRE(2 == utilization.size());
+  REQUIRE(Approx(0.75f) == utilization[0]);
+  REQUIRE(Approx(0.0f) == utilization[1]);
+  // cpu1 went offline: no comparison is possible.
+  auto hotplug = LinuxParser::ParseSystemStat("cpu  0 0 0 0 0 0 0 0\n"
+                                              "cpu0 200 0 100 900 0 0 0 0\n");
+  LinuxParser::CoreUtilization(current->cores, hotplug->cores, utilization);
+  REQUIRE(1 == utilization.size());
+  REQUIRE(0.0f == utilization[0]);
+}
+TEST_CASE("Should not make a core busy when iowait decreases",
+          "[system_stat]") {
+  auto previous = LinuxParser::ParseSystemStat(
+      "cpu  0 0 0 0 0 0 0 0\n"
+      "cpu0 100 0 100 800 100 0 0 0\n"
+      "cpu1 100 0 100 800 100 0 0 0\n");
+  // cpu0 has a shorter idle time, cpu1 a shorter total.
+  auto current = LinuxParser::ParseSystemStat("cpu  0 0 0 0 0 0 0 0\n"
+                                              "cpu0 150 0 100 820 40 0 0 0\n"
+                                              "cpu1 100 0 100 800 50 0 0 0\n");
+  std::vector<float> utilization;
+  LinuxParser::CoreUtilization(previous->cores, current->cores, utilization);
+  REQUIRE(2 == utilization.size());
+  REQUIRE(0.0f == utilization[0]);
+  REQUIRE(0.0f == utilization[1]);
+}
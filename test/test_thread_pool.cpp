@@ -0,0 +1,50 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "thread_pool.h"
+
+TEST_CASE("Should run every index exactly once", "[thread_pool]") {
+  ThreadPool pool{4};
+  REQUIRE(4 == pool.Size());
+  std::vector<std::atomic<int>> hits(1000);
+  std::vector<std::size_t> per_worker(pool.Size());
+  pool.ParallelFor(hits.size(), 7,
+                   [&](std::size_t index, std::size_t worker) {
+                     hits[index]++;
+                     per_worker[worker]++;
+                   });
+  for (auto &hit : hits) {
+    REQUIRE(1 == hit.load());
+  }
+  REQUIRE(hits.size() == std::accumulate(per_worker.begin(), per_worker.end(),
+                                         std::size_t{0}));
+}
+TEST_CASE("Should run consecutive loops", "[thread_pool]") {
+  ThreadPool pool{0};
+  REQUIRE(1 == pool.Size());
+  std::atomic<std::size_t> total{0};
+  for (int loop = 0; loop < 10; ++loop) {
+    pool.ParallelFor(100, 3, [&](std::size_t index, std::size_t) {
+      total += index;
+    });
+  }
+  pool.ParallelFor(0, 3, [&](std::size_t, std::size_t) { total = 0; });
+  REQUIRE(10 * 4950 == total.load());
+}
+TEST_CASE("Should rethrow the errors of the loop", "[thread_pool]") {
+  ThreadPool pool{3};
+  std::atomic<int> runs{0};
+  REQUIRE_THROWS_AS(pool.ParallelFor(50, 1,
+                                     [&](std::size_t index, std::size_t) {
+                                       runs++;
+                                       if (index == 10) {
+                                         throw std::runtime_error("failed");
+                                       }
+                                     }),
+                    std::runtime_error);
+  // the other chunks are not cancelled.
+  REQUIRE(50 == runs.load());
+}
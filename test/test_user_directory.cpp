@@ -0,0 +1,40 @@
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "catch2/catch.hpp"
+#include "user_directory.h"
+
+TEST_CASE("Should find users by uid", "[user_directory]") {
+  std::filesystem::path passwd{"/tmp/monitor_passwd"};
+  {
+    std::ofstream out{passwd};
+    out << "root:x:0:0:root:/root:/bin/bash\n"
+        << "daemon:x:1:1:daemon:/usr/sbin:/usr/sbin/nologin\n"
+        << "broken line\n"
+        << "user10:x:10:10::/home/user10:/bin/sh\n"
+        << "user100:x:100:100::/home/user100:/bin/sh\n"
+        << "alias100:x:100:100::/home/user100:/bin/sh\n";
+  }
+  UserDirectory directory{passwd};
+  REQUIRE(4 == directory.Size());
+  REQUIRE("root" == directory.Find(0));
+  REQUIRE("user10" == directory.Find(10));
+  // the uid 10 must not match the uid 100 as a substring
+  REQUIRE("user100" == directory.Find(100));
+  REQUIRE("4242" == directory.Find(4242));
+  // nothing has changed, no reload
+  REQUIRE(false == directory.Refresh());
+  {
+    std::ofstream out{passwd, std::ios::app};
+    out << "newcomer:x:4242:4242::/home/newcomer:/bin/sh\n";
+  }
+  REQUIRE(true == directory.Refresh());
+  REQUIRE("newcomer" == directory.Find(4242));
+  REQUIRE(true == std::filesystem::remove(passwd));
+}
+TEST_CASE("Should find the current user", "[user_directory]") {
+  REQUIRE(UserDirectory::Instance().Size() > 0);
+  REQUIRE("root" == UserDirectory::Instance().Find(0));
+}
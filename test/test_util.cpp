@@ -58,3 +58,33 @@ TEST_CASE("Should split a string correctly", "[util]") {
   REQUIRE("is" == v[2]);
   REQUIRE("long" == v[3]);
 }
+TEST_CASE("Should tokenize without copies", "[util]") {
+  std::string value{"  cpu0 12  34\t56 "};
+  std::vector<std::string_view> tokens;
+  for (auto token : util::Tokenizer(value, " \t")) {
+    tokens.push_back(token);
+  }
+  REQUIRE(4 == tokens.size());
+  REQUIRE("cpu0" == tokens[0]);
+  REQUIRE("56" == tokens[3]);
+  // views on the original string.
+  REQUIRE(value.data() + 2 == tokens[0].data());
+  REQUIRE("34" == util::Tokenizer(value, " \t").at(2));
+  REQUIRE(util::Tokenizer(value, " \t").at(4).empty());
+  REQUIRE(util::Tokenizer("", " ").begin() == util::Tokenizer("", " ").end());
+}
+TEST_CASE("Should trim and split views", "[util]") {
+  REQUIRE("Barcelona" == util::trimmed(" \tBarcelona\n"));
+  REQUIRE(util::trimmed("   ").empty());
+  auto [key, value] = util::split_view("MemTotal:    16316412 kB", ":");
+  REQUIRE("MemTotal" == key);
+  REQUIRE("16316412 kB" == value);
+}
+TEST_CASE("Should parse numbers without exceptions", "[util]") {
+  REQUIRE(42 == util::parse<int>(" 42\n"));
+  REQUIRE(std::nullopt == util::parse<int>("42abc"));
+  REQUIRE(std::nullopt == util::parse<int>(""));
+  REQUIRE(Approx(2712.5) == util::parse<double>("2712.5").value());
+  REQUIRE(3072 == util::parse_prefix<int>("3072 KB"));
+  REQUIRE(std::nullopt == util::parse_prefix<int>("KB"));
+}